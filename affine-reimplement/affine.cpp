@@ -20,39 +20,56 @@
 //
 //==============================================================================
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <ostream>
 #include "affine.hpp"
-#include "affine_pair_iterator.hpp"
 #include "diagnostics.hpp"
 #include "exceptions.hpp"
 #include "lp_solver.hpp"
+#include "noise_merge.hpp"
 
 namespace asol {
 
-int affine::max_used_index(0);
-
-std::vector<interval>* affine::v(0);
+const double affine::NARROW(1.0e-6);
 
-lp_solver* affine::lp(0);
+namespace {
 
-bool affine::excellent_progress_made(false);
+const int INLINE_TERMS = 32; // noise terms of the temporaries on the stack
 
-const double affine::NARROW(1.0e-6);
+}
 
 void affine::set_vector(std::vector<interval>* vec) {
 
-	v = vec;
+	solver_context::current().affine_ranges = vec;
 }
 
 void affine::set_lp_solver(lp_solver* solver) {
 
-	lp = solver;
+	solver_context::current().lp = solver;
 }
 
 void affine::reset_counter() {
 
-	max_used_index = 0;
+	max_used_index() = 0;
+}
+
+void affine::set_noise_term_limit(int k) {
+
+	ASSERT2(k>=0, "k: "<<k);
+
+	solver_context::current().noise_term_limit = k;
+}
+
+void affine::keep_noise_terms() {
+
+	solver_context::current().noise.set_mark();
+}
+
+void affine::release_noise_terms() {
+
+	solver_context::current().noise.rewind();
 }
 
 void affine::add_noise_var(int index, double coeff) {
@@ -70,7 +87,9 @@ void affine::make_variable() {
 
 	add_noise_var(               0, rng.midpoint());
 
-	add_noise_var(++max_used_index, rng.radius()  );
+	add_noise_var(++max_used_index(), rng.radius()  );
+
+	last_variable_index() = max_used_index();
 }
 
 void affine::recompute_variable(int i) {
@@ -79,13 +98,13 @@ void affine::recompute_variable(int i) {
 
 	ASSERT(range_index==i);
 
-	ASSERT(max_used_index==i);
+	ASSERT(max_used_index()==i);
 
 	const interval rng = range();
 
 	ASSERT2(!rng.degenerate() , "index, range: " << range_index << ", " << rng);
 
-	set_var_range(++max_used_index, rng);
+	set_var_range(++max_used_index(), rng);
 }
 
 void affine::set_var_range(int index, const interval& rng) {
@@ -166,7 +185,7 @@ void affine::set_range_with_epsilon_bounds(const double lb, const double ub) {
 	// FIXME Hideous and knows a lot about progress and termination computation
 	if (!x.is_narrow(0.05) && y.diameter()!=0 && x.diameter()/y.diameter()<0.749) {
 
-		excellent_progress_made = true;
+		excellent_progress_made() = true;
 	}
 }
 
@@ -187,16 +206,11 @@ std::ostream& operator<<(std::ostream& os, const affine& x) {
 template <typename T>
 void binary_op(const affine& x, const affine& y, T bin_op) {
 
-	affine_pair_iterator itr(x, y);
-
-	bin_op.init_z0(itr.x_i(), itr.y_i());
-
-	while ( itr.increment() ) {
-
-		bin_op.set_zi(itr.index(), itr.x_i(), itr.y_i());
-	}
+	merge_noise_terms(x, y, bin_op);
 
 	bin_op.set_z_range(x.range(), y.range());
+
+	bin_op.limit_noise_terms();
 }
 
 template <typename T>
@@ -204,7 +218,12 @@ class binary_operation {
 
 public:
 
-	binary_operation(affine& z) : z(z), rad(0), c(0) { z.noise_vars.clear(); }
+	binary_operation(affine& z, const affine& x, const affine& y) : z(z), rad(0), c(0) {
+
+		z.noise_vars.clear();
+
+		z.noise_vars.reserve(x.size()+y.size());
+	}
 
 	void init_z0(double x0, double y0);
 
@@ -212,6 +231,8 @@ public:
 
 	void set_z_range(const interval& x, const interval& y);
 
+	void limit_noise_terms() { z.limit_noise_terms(); }
+
 private:
 
 	void intersect_range() {
@@ -279,45 +300,62 @@ inline void binary_operation<Sub>::set_z_range(const interval& x, const interval
 
 void aa_addition(affine& z, const affine& x, const affine& y) {
 
-	binary_op(x, y, binary_operation<Add>(z));
+	binary_op(x, y, binary_operation<Add>(z, x, y));
 }
 
 void aa_substraction(affine& z, const affine& x, const affine& y) {
 
-	binary_op(x, y, binary_operation<Sub>(z));
+	binary_op(x, y, binary_operation<Sub>(z, x, y));
 }
 
-void aa_multiplication(affine& z, const affine& x, const affine& y) {
-
-	z.noise_vars.clear();
-	z.noise_vars.reserve(x.size()+y.size()+1);
+// Collects the linear part of x*y and the sums needed for its error term
+struct product_terms {
 
-	affine_pair_iterator itr(x, y);
+	explicit product_terms(noise_terms& z) : z(z), x0(0), y0(0), rad(0), rad_x(0), rad_y(0), c(0) { }
 
-	const double x0 = itr.x_i();
-	const double y0 = itr.y_i();
+	void init_z0(double x_0, double y_0) {
 
-	double rad(0), rad_x(0), rad_y(0), c(0);
+		x0 = x_0;
+		y0 = y_0;
 
-	z.add_noise_var(0, 0);
-
-	while ( itr.increment() ) {
+		z.push_back(epsilon(0, 0));
+	}
 
-		const double x_i = itr.x_i();
-		const double y_i = itr.y_i();
+	void set_zi(int index, double x_i, double y_i) {
 
 		c += x_i*y_i;
 
 		const double tmp = x0*y_i+y0*x_i;
 
-		z.add_noise_var(itr.index(), tmp);
+		z.push_back(epsilon(index, tmp));
 
-	    rad   += std::fabs(tmp);
+		rad   += std::fabs(tmp);
 		rad_x += std::fabs(x_i);
 		rad_y += std::fabs(y_i);
 	}
 
-	c /= 2.0;
+	noise_terms& z;
+	double x0, y0;
+	double rad, rad_x, rad_y, c;
+};
+
+void aa_multiplication(affine& z, const affine& x, const affine& y) {
+
+	z.noise_vars.clear();
+	z.noise_vars.reserve(x.size()+y.size()+1);
+
+	product_terms terms(z.noise_vars);
+
+	merge_noise_terms(x, y, terms);
+
+	const double x0 = terms.x0;
+	const double y0 = terms.y0;
+
+	double rad = terms.rad;
+
+	const double rad_x = terms.rad_x, rad_y = terms.rad_y;
+
+	double c = terms.c / 2.0;
 
 	const double mid = x0*y0 + c;
 
@@ -327,12 +365,14 @@ void aa_multiplication(affine& z, const affine& x, const affine& y) {
 
 	ASSERT(delta >= 0.0);
 
-	z.add_noise_var(++affine::max_used_index, delta);
+	z.add_noise_var(++affine::max_used_index(), delta);
 
 	rad += delta;
 
 	z.force_intersection(mid-rad, mid+rad);
 	z.force_intersection(x.range()*y.range());
+
+	z.limit_noise_terms();
 }
 
 struct DivP { };
@@ -363,13 +403,17 @@ void aa_division(affine& z, const affine& x, const affine& y) {
 
 	ASSERT(y.central_value()!=0.0);
 
-	const int start_index = affine::max_used_index;
+	const int start_index = affine::max_used_index();
+
+	epsilon P_buffer[INLINE_TERMS];
 
-	affine P(interval::ANY_REAL());
+	affine P(interval::ANY_REAL(), P_buffer, INLINE_TERMS);
 
-	binary_op(x, y, binary_operation<DivP>(P));
+	binary_op(x, y, binary_operation<DivP>(P, x, y));
 
-	affine Q(interval::ANY_REAL());
+	epsilon Q_buffer[INLINE_TERMS];
+
+	affine Q(interval::ANY_REAL(), Q_buffer, INLINE_TERMS);
 
 	aa_reciprocal(Q, y);
 
@@ -389,23 +433,25 @@ void aa_division(affine& z, const affine& x, const affine& y) {
 
 	z.force_intersection(x.range()/y.range());
 
-	const int new_indices = affine::max_used_index - start_index;
+	const int new_indices = affine::max_used_index() - start_index;
 
 	if (new_indices == 2) {
 
 		z.condense_last_two_noise_vars();
 	}
+
+	z.limit_noise_terms();
 }
 
 void affine::condense_last_two_noise_vars() {
 
-	ASSERT(affine::max_used_index == noise_vars.back().index);
+	ASSERT(affine::max_used_index() == noise_vars.back().index);
 
-	--affine::max_used_index;
+	--affine::max_used_index();
 
 	epsilon& before_last = noise_vars.at(size()-2);
 
-	ASSERT(before_last.index == affine::max_used_index);
+	ASSERT(before_last.index == affine::max_used_index());
 
 	ASSERT(std::fabs(before_last.coeff) < 1.0e-12);
 
@@ -418,6 +464,81 @@ void affine::condense_last_two_noise_vars() {
 	noise_vars.pop_back();
 }
 
+// Reduced affine arithmetic: the smallest terms of the non-variables are
+// folded into a fresh symbol so that at most limit of them remain
+void affine::limit_noise_terms() {
+
+	solver_context& context = solver_context::current();
+
+	const int limit = context.noise_term_limit;
+
+	if (limit == 0) {
+
+		return;
+	}
+
+	const int n = size();
+
+	int first = 1;
+
+	while (first<n && noise_vars.at(first).index <= context.last_variable_index) {
+
+		++first;
+	}
+
+	const int n_fold = n - first - limit + 1;
+
+	if (n_fold <= 1) {
+
+		return;
+	}
+
+	std::vector<double>& magnitudes = context.magnitudes;
+
+	magnitudes.clear();
+
+	for (int i=first; i<n; ++i) {
+
+		magnitudes.push_back(std::fabs(noise_vars.at(i).coeff));
+	}
+
+	std::nth_element(magnitudes.begin(), magnitudes.begin()+(n_fold-1), magnitudes.end());
+
+	const double threshold = magnitudes.at(n_fold-1);
+
+	int ties_to_fold = n_fold - static_cast<int>(std::count_if(magnitudes.begin(),
+			magnitudes.end(), std::bind2nd(std::less<double>(), threshold)));
+
+	double folded = 0.0;
+
+	int k = first;
+
+	for (int i=first; i<n; ++i) {
+
+		const epsilon e = noise_vars.at(i);
+
+		const double mag = std::fabs(e.coeff);
+
+		if (mag < threshold || (mag == threshold && ties_to_fold-- > 0)) {
+
+			folded += mag;
+		}
+		else {
+
+			noise_vars.at(k++) = e;
+		}
+	}
+
+	ASSERT2(k == n - n_fold, "k, n, n_fold: "<<k<<", "<<n<<", "<<n_fold);
+
+	while (size() > k) {
+
+		noise_vars.pop_back();
+	}
+
+	add_noise_var(++max_used_index(), folded);
+}
+
 // TODO Finish
 void affine::equals(double value) {
 
@@ -425,15 +546,15 @@ void affine::equals(double value) {
 
 	ASSERT(merge().contains(value));
 
-	lp->add_equality_constraint(*this, value);
+	lp()->add_equality_constraint(*this, value);
 
-	affine::excellent_progress_made = false;
+	affine::excellent_progress_made() = false;
 
-	//lp->prune_upcoming_variables();
+	//lp()->prune_upcoming_variables();
 
-	if (affine::excellent_progress_made) {
+	if (affine::excellent_progress_made()) {
 
-		affine::excellent_progress_made = false;
+		affine::excellent_progress_made() = false;
 
 		throw excellent_progress();
 	}
@@ -450,7 +571,7 @@ void affine::unary_op(const affine& arg, double alpha, double zeta, double delta
 
 	ASSERT2(delta > 0, "delta: " << delta);
 
-	const std::vector<epsilon>& x = arg.noise_vars;
+	const noise_terms& x = arg.noise_vars;
 
 	const int n = arg.size();
 
@@ -465,9 +586,11 @@ void affine::unary_op(const affine& arg, double alpha, double zeta, double delta
 		add_noise_var(e.index, alpha*e.coeff);
 	}
 
-	add_noise_var(++affine::max_used_index, delta);
+	add_noise_var(++affine::max_used_index(), delta);
 
 	central_value() += zeta;
+
+	limit_noise_terms();
 }
 
 void aa_exp(affine& z, const affine& x) {
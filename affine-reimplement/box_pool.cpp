@@ -0,0 +1,190 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <new>
+#include "box_pool.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+
+namespace {
+
+const std::size_t CACHE_LINE = 64;
+
+const int SLABS_PER_CHUNK = 1024;
+
+std::size_t round_up(std::size_t bytes) {
+
+	return ((bytes+CACHE_LINE-1)/CACHE_LINE)*CACHE_LINE;
+}
+
+}
+
+namespace asol {
+
+box_pool::box_pool(int size) :
+
+	n_vars(size),
+	stride(round_up(size*sizeof(interval)+sizeof(slab_header))),
+	free_head(0),
+	in_use(0),
+	peak(0),
+	n_chunks(0),
+	unused_slot(0)
+{
+	ASSERT2(n_vars > 0, "n_vars: "<<n_vars);
+}
+
+box_pool::~box_pool() {
+
+	for (int i=0; i<n_chunks; ++i) {
+
+		delete[] raw_chunks[i];
+	}
+}
+
+char* box_pool::slab(int slot) const {
+
+	return chunks[slot/SLABS_PER_CHUNK] + (slot%SLABS_PER_CHUNK)*stride;
+}
+
+box_pool::slab_header* box_pool::header(int slot) const {
+
+	return reinterpret_cast<slab_header*>(slab(slot) + n_vars*sizeof(interval));
+}
+
+interval* box_pool::allocate() {
+
+	for ( ; ; ) {
+
+		const word head = __sync_fetch_and_add(&free_head, 0);
+
+		const int slot = static_cast<int>(head & 0xFFFFFFFFu) - 1;
+
+		if (slot < 0) {
+
+			return new_slab();
+		}
+
+		// Stale if another thread has taken the slab, the CAS fails then; read
+		// atomically as release() may be writing it
+		const int next = __sync_fetch_and_add(&header(slot)->next, 0);
+
+		const word new_head = (((head >> 32) + 1) << 32) | static_cast<word>(next+1);
+
+		if (__sync_bool_compare_and_swap(&free_head, head, new_head)) {
+
+			count_allocation();
+
+			return construct_box(slot);
+		}
+	}
+}
+
+void box_pool::release(interval* box) {
+
+	slab_header* const h = reinterpret_cast<slab_header*>(reinterpret_cast<char*>(box) + n_vars*sizeof(interval));
+
+	// unused_slot is not read here, it is guarded by chunk_lock
+	ASSERT2(0<=h->slot && slab(h->slot)==reinterpret_cast<char*>(box), "not a box of the pool");
+
+	for ( ; ; ) {
+
+		const word head = __sync_fetch_and_add(&free_head, 0);
+
+		__sync_lock_test_and_set(&h->next, static_cast<int>(head & 0xFFFFFFFFu) - 1);
+
+		const word new_head = (((head >> 32) + 1) << 32) | static_cast<word>(h->slot+1);
+
+		if (__sync_bool_compare_and_swap(&free_head, head, new_head)) {
+
+			break;
+		}
+	}
+
+	__sync_sub_and_fetch(&in_use, 1);
+}
+
+interval* box_pool::new_slab() {
+
+	int slot = 0;
+
+	{
+		scoped_lock lock(chunk_lock);
+
+		if (unused_slot == n_chunks*SLABS_PER_CHUNK) {
+
+			if (n_chunks == MAX_CHUNKS) {
+
+				throw std::bad_alloc(); // the chunk table is full, even with the asserts off
+			}
+
+			char* const raw = new char[SLABS_PER_CHUNK*stride + CACHE_LINE];
+
+			const std::size_t misalignment = reinterpret_cast<std::size_t>(raw) % CACHE_LINE;
+
+			raw_chunks[n_chunks] = raw;
+
+			chunks[n_chunks] = misalignment ? raw + (CACHE_LINE - misalignment) : raw;
+
+			++n_chunks;
+		}
+
+		slot = unused_slot++;
+	}
+
+	header(slot)->slot = slot;
+
+	count_allocation();
+
+	return construct_box(slot);
+}
+
+interval* box_pool::construct_box(int slot) {
+
+	interval* const box = reinterpret_cast<interval*>(slab(slot));
+
+	for (int i=0; i<n_vars; ++i) {
+
+		new (box+i) interval();
+	}
+
+	return box;
+}
+
+void box_pool::count_allocation() {
+
+	const int boxes = __sync_add_and_fetch(&in_use, 1);
+
+	int old_peak = __sync_fetch_and_add(&peak, 0);
+
+	while (boxes > old_peak && !__sync_bool_compare_and_swap(&peak, old_peak, boxes)) {
+
+		old_peak = __sync_fetch_and_add(&peak, 0);
+	}
+}
+
+std::size_t box_pool::memory() const {
+
+	return n_chunks*(SLABS_PER_CHUNK*stride + CACHE_LINE);
+}
+
+}
@@ -0,0 +1,334 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include "box_queue.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+
+namespace {
+
+const std::size_t DEFAULT_MEMORY_BUDGET = 64*1024*1024;
+
+}
+
+namespace asol {
+
+search_options::search_options()
+: order(BREADTH_FIRST),
+  heuristic(SMALLEST_MAX_WIDTH),
+  memory_budget(DEFAULT_MEMORY_BUDGET),
+  compact_frontier(false),
+  ram_budget(0),
+  spill_file(0)
+{
+
+}
+
+template <typename T>
+box_queue<T>::box_queue() : peak(0) {
+
+}
+
+template <typename T>
+box_queue<T>::~box_queue() {
+	// The boxes belong to the box_pool of the search
+}
+
+template <typename T>
+void box_queue<T>::update_peak() {
+
+	if (size() > peak) {
+
+		peak = size();
+	}
+}
+
+namespace {
+
+template <typename T>
+class fifo_queue : public box_queue<T> {
+
+private:
+
+	virtual void push(T* box, double ) {
+
+		boxes.push_back(box);
+
+		this->update_peak();
+	}
+
+	virtual T* pop() {
+
+		ASSERT(!boxes.empty());
+
+		T* box = boxes.front();
+
+		boxes.pop_front();
+
+		return box;
+	}
+
+	virtual int size() const { return static_cast<int>(boxes.size()); }
+
+	virtual void visit_all(typename box_queue<T>::visitor& v) const {
+
+		for (size_t i=0; i<boxes.size(); ++i) {
+
+			v.visit(boxes[i], -1);
+		}
+	}
+
+	std::deque<T*> boxes;
+};
+
+template <typename T>
+class lifo_queue : public box_queue<T> {
+
+private:
+
+	virtual void push(T* box, double ) {
+
+		boxes.push_back(box);
+
+		this->update_peak();
+	}
+
+	virtual T* pop() {
+
+		ASSERT(!boxes.empty());
+
+		T* box = boxes.back();
+
+		boxes.pop_back();
+
+		return box;
+	}
+
+	virtual int size() const { return static_cast<int>(boxes.size()); }
+
+	virtual void visit_all(typename box_queue<T>::visitor& v) const {
+
+		for (size_t i=0; i<boxes.size(); ++i) {
+
+			v.visit(boxes[i], -1);
+		}
+	}
+
+	std::vector<T*> boxes;
+};
+
+template <typename T>
+struct entry {
+
+	entry(T* b, double p, long s) : box(b), priority(p), seq(s) { }
+
+	T* box;
+
+	double priority;
+
+	long seq;
+};
+
+// The top of the heap is the largest element
+template <typename T>
+struct worse {
+
+	bool operator()(const entry<T>& x, const entry<T>& y) const {
+
+		return x.priority != y.priority ? x.priority > y.priority : x.seq > y.seq;
+	}
+};
+
+template <typename T>
+struct earlier {
+
+	bool operator()(const entry<T>& x, const entry<T>& y) const { return x.seq < y.seq; }
+};
+
+template <typename T>
+class best_first_queue : public box_queue<T> {
+
+public:
+
+	best_first_queue() : pushes(0) { }
+
+protected:
+
+	void push_to_heap(T* box, double priority) {
+
+		heap.push_back(entry<T>(box, priority, pushes++));
+
+		std::push_heap(heap.begin(), heap.end(), worse<T>());
+	}
+
+	T* pop_from_heap() {
+
+		ASSERT(!heap.empty());
+
+		std::pop_heap(heap.begin(), heap.end(), worse<T>());
+
+		T* box = heap.back().box;
+
+		heap.pop_back();
+
+		return box;
+	}
+
+	int heap_size() const { return static_cast<int>(heap.size()); }
+
+	void visit_heap(typename box_queue<T>::visitor& v) const {
+
+		std::vector<entry<T> > entries(heap);
+
+		std::sort(entries.begin(), entries.end(), earlier<T>());
+
+		for (size_t i=0; i<entries.size(); ++i) {
+
+			v.visit(entries[i].box, -1);
+		}
+	}
+
+private:
+
+	virtual void push(T* box, double priority) {
+
+		push_to_heap(box, priority);
+
+		this->update_peak();
+	}
+
+	virtual T* pop() { return pop_from_heap(); }
+
+	virtual int size() const { return heap_size(); }
+
+	virtual void visit_all(typename box_queue<T>::visitor& v) const { visit_heap(v); }
+
+	std::vector<entry<T> > heap;
+
+	long pushes;
+};
+
+// While the queue is over the budget, the best box is taken off the heap
+// and its descendants are processed depth-first on the stack; the heap
+// does not grow meanwhile. Best-first order resumes when the stack is
+// empty and the heap is below the budget.
+template <typename T>
+class hybrid_queue : public best_first_queue<T> {
+
+public:
+
+	explicit hybrid_queue(int max_boxes) : budget(max_boxes), diving(false) { }
+
+private:
+
+	virtual void push(T* box, double priority) {
+
+		if (diving) {
+
+			stack.push_back(box);
+		}
+		else {
+
+			this->push_to_heap(box, priority);
+		}
+
+		this->update_peak();
+	}
+
+	virtual T* pop() {
+
+		if (!stack.empty()) {
+
+			T* box = stack.back();
+
+			stack.pop_back();
+
+			return box;
+		}
+
+		diving = this->heap_size() > budget;
+
+		return this->pop_from_heap();
+	}
+
+	virtual int size() const { return this->heap_size() + static_cast<int>(stack.size()); }
+
+	virtual void visit_all(typename box_queue<T>::visitor& v) const {
+
+		this->visit_heap(v);
+
+		for (size_t i=0; i<stack.size(); ++i) {
+
+			v.visit(stack[i], -1);
+		}
+	}
+
+	const int budget;
+
+	bool diving;
+
+	std::vector<T*> stack;
+};
+
+}
+
+template <typename T>
+box_queue<T>* box_queue<T>::new_queue(const search_options& options, int n_vars) {
+
+	box_queue<T>* queue = 0;
+
+	if (options.order == BREADTH_FIRST) {
+
+		queue = new fifo_queue<T>;
+	}
+	else if (options.order == DEPTH_FIRST) {
+
+		queue = new lifo_queue<T>;
+	}
+	else if (options.order == BEST_FIRST) {
+
+		queue = new best_first_queue<T>;
+	}
+	else if (options.order == HYBRID) {
+
+		const std::size_t box_size = n_vars*sizeof(interval);
+
+		const std::size_t max_boxes = options.memory_budget/box_size;
+
+		queue = new hybrid_queue<T>(max_boxes > 1 ? static_cast<int>(max_boxes) : 1);
+	}
+	else {
+
+		ASSERT2(false, "unknown search order: "<<options.order);
+	}
+
+	return queue;
+}
+
+template class box_queue<interval>;
+
+template class box_queue<const split_node>;
+
+}
@@ -0,0 +1,179 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include "box_scheduler.hpp"
+#include "box_pool.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+
+namespace asol {
+
+box_scheduler::box_scheduler(int number_of_workers, int n_vars) :
+
+	n_workers(number_of_workers),
+	pool(new box_pool(n_vars)),
+	queues(number_of_workers),
+	queue_locks(number_of_workers),
+	queued(0),
+	in_flight(0),
+	steal_counter(0)
+{
+	ASSERT2(n_workers > 0, "workers: "<<n_workers);
+
+	for (int i=0; i<n_workers; ++i) {
+
+		queue_locks.at(i) = new mutex;
+	}
+}
+
+box_scheduler::~box_scheduler() {
+
+	for (int i=0; i<n_workers; ++i) {
+
+		delete queue_locks.at(i);
+	}
+
+	delete pool; // with the boxes left in the deques
+}
+
+void box_scheduler::push(int worker, interval* box) {
+
+	{
+		scoped_lock lock(*queue_locks.at(worker));
+
+		queues.at(worker).push_back(box);
+	}
+
+	scoped_lock lock(state_lock);
+
+	++queued;
+
+	work_available.signal();
+}
+
+interval* box_scheduler::pop_own(int worker) {
+
+	scoped_lock lock(*queue_locks.at(worker));
+
+	std::deque<interval*>& q = queues.at(worker);
+
+	if (q.empty()) {
+
+		return 0;
+	}
+
+	interval* box = q.back();
+
+	q.pop_back();
+
+	return box;
+}
+
+interval* box_scheduler::steal(int thief) {
+
+	for (int k=1; k<n_workers; ++k) {
+
+		const int victim = (thief + k) % n_workers;
+
+		scoped_lock lock(*queue_locks.at(victim));
+
+		std::deque<interval*>& q = queues.at(victim);
+
+		if (!q.empty()) {
+
+			interval* box = q.front();
+
+			q.pop_front();
+
+			return box;
+		}
+	}
+
+	return 0;
+}
+
+void box_scheduler::took_box() {
+
+	scoped_lock lock(state_lock);
+
+	--queued;
+
+	++in_flight;
+}
+
+interval* box_scheduler::pop(int worker) {
+
+	while (true) {
+
+		interval* box = pop_own(worker);
+
+		if (box) {
+
+			took_box();
+
+			return box;
+		}
+
+		box = steal(worker);
+
+		if (box) {
+
+			took_box();
+
+			scoped_lock lock(state_lock);
+
+			++steal_counter;
+
+			return box;
+		}
+
+		scoped_lock lock(state_lock);
+
+		if (queued==0 && in_flight==0) {
+
+			work_available.broadcast();
+
+			return 0;
+		}
+
+		if (queued==0) {
+
+			work_available.wait(state_lock);
+		}
+	}
+}
+
+void box_scheduler::box_done() {
+
+	scoped_lock lock(state_lock);
+
+	ASSERT2(in_flight > 0, "in flight: "<<in_flight);
+
+	--in_flight;
+
+	if (queued==0 && in_flight==0) {
+
+		work_available.broadcast();
+	}
+}
+
+}
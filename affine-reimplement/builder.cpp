@@ -24,6 +24,7 @@
 #include "builder.hpp"
 #include "problem_data.hpp"
 #include "diagnostics.hpp"
+#include "solver_context.hpp"
 
 namespace asol {
 
@@ -38,45 +39,48 @@ typedef equality_constraint<builder> Equality_constraint;
 typedef common_subexpression<builder> Common_subexpression;
 typedef less_than_or_equal_to<builder> Less_than_or_equal_to;
 
-problem_data* builder::problem = new problem_data;
+problem_data*& builder::problem() {
+
+	return solver_context::current().problem;
+}
 
 void builder::reset() {
 
 	builder::release();
 
-	problem = new problem_data;
+	problem() = new problem_data;
 }
 
 void builder::release() {
 
-	delete problem;
+	delete problem();
 
-	problem = 0;
+	problem() = 0;
 }
 
 const problem_data* builder::get_problem_data() {
 
-	return problem;
+	return problem();
 }
 
 void builder::finished() {
 
-	problem->build_index_set();
+	problem()->build_index_set();
 }
 
 builder::builder() : index(-1) {
 
 }
 
-builder::builder(double ) : index(problem->next_index()) {
+builder::builder(double ) : index(problem()->next_index()) {
 
 }
 
-builder::builder(double lb, double ub) : index(problem->next_index()) {
+builder::builder(double lb, double ub) : index(problem()->next_index()) {
 
 	ASSERT2(lb<=ub, "lb, ub: "<<lb<<", "<<ub);
 
-	problem->add_variable(lb, ub);
+	problem()->add_variable(lb, ub);
 }
 
 // FIXME This duplication is difficult to remove
@@ -86,7 +90,7 @@ const builder operator+(const builder& x, const builder& y) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Addition(z.index, x.index, y.index));
+	builder::problem()->add_primitive(new Addition(z.index, x.index, y.index));
 
 	return z;
 }
@@ -97,7 +101,7 @@ const builder operator-(const builder& x, const builder& y) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Substraction(z.index, x.index, y.index));
+	builder::problem()->add_primitive(new Substraction(z.index, x.index, y.index));
 
 	return z;
 }
@@ -108,7 +112,7 @@ const builder operator*(const builder& x, const builder& y) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Multiplication(z.index, x.index, y.index));
+	builder::problem()->add_primitive(new Multiplication(z.index, x.index, y.index));
 
 	return z;
 }
@@ -119,7 +123,7 @@ const builder operator/(const builder& x, const builder& y) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Division(z.index, x.index, y.index));
+	builder::problem()->add_primitive(new Division(z.index, x.index, y.index));
 
 	return z;
 }
@@ -130,7 +134,7 @@ const builder sqr(const builder& x) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Square(z.index, x.index));
+	builder::problem()->add_primitive(new Square(z.index, x.index));
 
 	return z;
 }
@@ -141,7 +145,7 @@ const builder exp(const builder& x) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Exponential(z.index, x.index));
+	builder::problem()->add_primitive(new Exponential(z.index, x.index));
 
 	return z;
 }
@@ -152,7 +156,7 @@ const builder log(const builder& x) {
 
 	const builder z(0);
 
-	builder::problem->add_primitive(new Logarithm(z.index, x.index));
+	builder::problem()->add_primitive(new Logarithm(z.index, x.index));
 
 	return z;
 }
@@ -161,7 +165,7 @@ const builder operator+(const builder& x, double y) {
 
 	const builder Y = builder(y);
 
-	builder::problem->add_numeric_constant(Y.index, y);
+	builder::problem()->add_numeric_constant(Y.index, y);
 
 	return x+Y;
 }
@@ -180,7 +184,7 @@ const builder operator-(double x, const builder& y) {
 
 	const builder X = builder(x);
 
-	builder::problem->add_numeric_constant(X.index, x);
+	builder::problem()->add_numeric_constant(X.index, x);
 
 	return X-y;
 }
@@ -189,7 +193,7 @@ const builder operator*(double x, const builder& y) {
 
 	const builder X = builder(x);
 
-	builder::problem->add_numeric_constant(X.index, x);
+	builder::problem()->add_numeric_constant(X.index, x);
 
 	return X*y;
 }
@@ -198,7 +202,7 @@ const builder operator/(double x, const builder& y) {
 
 	const builder X = builder(x);
 
-	builder::problem->add_numeric_constant(X.index, x);
+	builder::problem()->add_numeric_constant(X.index, x);
 
 	return X/y;
 }
@@ -207,18 +211,18 @@ void builder::mark_as_common_subexpression() const {
 
 	dbg_consistency();
 	// FIXME It is a sort of duplication
-	int ordinal = problem->add_common_subexpression(index);
+	int ordinal = problem()->add_common_subexpression(index);
 
-	problem->add_primitive(new Common_subexpression(index, ordinal));
+	problem()->add_primitive(new Common_subexpression(index, ordinal));
 }
 
 void builder::equals(double value) const {
 
 	dbg_consistency();
 
-	int constraint_offset = problem->add_constraint_rhs(value);
+	int constraint_offset = problem()->add_constraint_rhs(value);
 
-	problem->add_primitive(new Equality_constraint(index, constraint_offset, value));
+	problem()->add_primitive(new Equality_constraint(index, constraint_offset, value));
 }
 
 void builder::less_than_or_equal_to(const builder& rhs) const {
@@ -226,12 +230,12 @@ void builder::less_than_or_equal_to(const builder& rhs) const {
 	dbg_consistency();
 	rhs.dbg_consistency();
 
-	problem->add_primitive(new Less_than_or_equal_to(index, rhs.index));
+	problem()->add_primitive(new Less_than_or_equal_to(index, rhs.index));
 }
 
 void builder::dbg_consistency() const {
 
-	ASSERT2(0<=index && index<problem->peek_index(), "index, unused_index: "<<index<<", "<<problem->peek_index());
+	ASSERT2(0<=index && index<problem()->peek_index(), "index, unused_index: "<<index<<", "<<problem()->peek_index());
 }
 
 void dbg_consistency(const builder& x, const builder& y) {
@@ -0,0 +1,234 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <cstring>
+#include <unistd.h>
+#include "checkpoint.hpp"
+#include "diagnostics.hpp"
+#include "vector_dump.hpp"
+
+namespace {
+
+const char MAGIC[] = "ASOLCKP2";
+
+const int MAGIC_SIZE = 8;
+
+template <typename T>
+void write_values(FILE* out, const T* values, int n) {
+
+	const std::size_t written = std::fwrite(values, sizeof(T), n, out);
+
+	ASSERT2(written == static_cast<std::size_t>(n), "failed to write the checkpoint");
+}
+
+template <typename T>
+void write_value(FILE* out, const T& value) {
+
+	write_values(out, &value, 1);
+}
+
+template <typename T>
+void read_values(std::ifstream& in, T* values, int n) {
+
+	in.read(reinterpret_cast<char*>(values), n*sizeof(T));
+
+	ASSERT2(in.good(), "truncated checkpoint");
+}
+
+template <typename T>
+void read_value(std::ifstream& in, T& value) {
+
+	read_values(in, &value, 1);
+}
+
+int read_length(std::ifstream& in) {
+
+	int n = 0;
+
+	read_value(in, n);
+
+	ASSERT2(n >= 0, "corrupt checkpoint, length: "<<n);
+
+	return n;
+}
+
+}
+
+namespace asol {
+
+// The record of a box is its bounds as in pack(), then its depth
+checkpoint_writer::checkpoint_writer(const char* file_name, const checkpoint_header& header)
+: file(file_name),
+  tmp(file + ".tmp"),
+  n_vars(header.n_vars),
+  pending_boxes(header.pending_boxes),
+  record(2*n_vars+1),
+  out(std::fopen(tmp.c_str(), "wb")),
+  written(0)
+{
+	ASSERT2(out != NULL, "failed to open "<<tmp);
+
+	write_values(out, MAGIC, MAGIC_SIZE);
+
+	write_value(out, header.n_vars);
+
+	const int length = static_cast<int>(header.strategy.size());
+
+	write_value(out, length);
+
+	write_values(out, header.strategy.c_str(), length);
+
+	write_value(out, header.solutions_found);
+	write_value(out, header.splits);
+	write_value(out, header.boxes_processed);
+	write_value(out, header.splits_to_first_solution);
+	write_value(out, header.solutions_proved);
+
+	const int counters = static_cast<int>(header.found_counters.size());
+
+	write_value(out, counters);
+
+	if (counters > 0) {
+
+		write_values(out, &header.found_counters.at(0), counters);
+	}
+
+	const int solutions = static_cast<int>(header.solutions.size())/n_vars;
+
+	write_value(out, solutions);
+
+	for (int i=0; i<solutions; ++i) {
+
+		pack(&header.solutions.at(i*n_vars), n_vars, &record.at(0));
+
+		write_values(out, &record.at(0), 2*n_vars);
+	}
+
+	write_value(out, pending_boxes);
+}
+
+void checkpoint_writer::add_box(const interval* box, int depth) {
+
+	pack(box, n_vars, &record.at(0));
+
+	record.at(2*n_vars) = depth;
+
+	write_values(out, &record.at(0), 2*n_vars+1);
+
+	++written;
+}
+
+void checkpoint_writer::commit() {
+
+	ASSERT2(written == pending_boxes, "written, pending: "<<written<<", "<<pending_boxes);
+
+	const bool failed = std::fflush(out) != 0 || fsync(fileno(out)) != 0;
+
+	std::fclose(out);
+
+	out = 0;
+
+	ASSERT2(!failed, "failed to flush "<<tmp);
+
+	const int renamed = std::rename(tmp.c_str(), file.c_str());
+
+	ASSERT2(renamed == 0, "failed to rename "<<tmp);
+}
+
+checkpoint_writer::~checkpoint_writer() {
+
+	if (out) {
+
+		std::fclose(out);
+
+		std::remove(tmp.c_str());
+	}
+}
+
+checkpoint_reader::checkpoint_reader(const char* file) : in(file, std::ios::binary), read(0) {
+
+	char magic[MAGIC_SIZE];
+
+	in.read(magic, MAGIC_SIZE);
+
+	ASSERT2(in && std::memcmp(magic, MAGIC, MAGIC_SIZE)==0, "not a checkpoint: "<<file);
+
+	read_value(in, head.n_vars);
+
+	ASSERT2(head.n_vars > 0, "corrupt checkpoint, variables: "<<head.n_vars);
+
+	std::vector<char> strategy(read_length(in)+1, '\0');
+
+	read_values(in, &strategy.at(0), static_cast<int>(strategy.size())-1);
+
+	head.strategy = &strategy.at(0);
+
+	read_value(in, head.solutions_found);
+	read_value(in, head.splits);
+	read_value(in, head.boxes_processed);
+	read_value(in, head.splits_to_first_solution);
+	read_value(in, head.solutions_proved);
+
+	const int counters = read_length(in);
+
+	head.found_counters.assign(counters, 0);
+
+	if (counters > 0) {
+
+		read_values(in, &head.found_counters.at(0), counters);
+	}
+
+	const int solutions = read_length(in);
+
+	record.assign(2*head.n_vars+1, 0.0);
+
+	head.solutions.assign(solutions*head.n_vars, interval(0.0));
+
+	for (int i=0; i<solutions; ++i) {
+
+		read_values(in, &record.at(0), 2*head.n_vars);
+
+		unpack(&record.at(0), head.n_vars, &head.solutions.at(i*head.n_vars));
+	}
+
+	head.pending_boxes = read_length(in);
+}
+
+bool checkpoint_reader::next_box(interval* box, int& depth) {
+
+	if (read == head.pending_boxes) {
+
+		return false;
+	}
+
+	read_values(in, &record.at(0), static_cast<int>(record.size()));
+
+	unpack(&record.at(0), head.n_vars, box);
+
+	depth = static_cast<int>(record.back());
+
+	++read;
+
+	return true;
+}
+
+}
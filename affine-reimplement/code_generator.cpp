@@ -0,0 +1,320 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include "code_generator.hpp"
+#include "problem_data.hpp"
+
+using namespace std;
+
+namespace {
+
+const string v(int index) {
+
+	ostringstream os;
+
+	os << "v[" << index << "]";
+
+	return os.str();
+}
+
+const string call(const char* function, int z, int x) {
+
+	return string(function) + "(" + v(z) + ", " + v(x) + ");";
+}
+
+const string call(const char* function, int z, int x, int y) {
+
+	return string(function) + "(" + v(z) + ", " + v(x) + ", " + v(y) + ");";
+}
+
+const string call_with_gap(const char* function, int z, int x) {
+
+	return string(function) + "(" + v(z) + ", " + v(x) + ", gap);";
+}
+
+const string call_with_gap(const char* function, int z, int x, int y) {
+
+	return string(function) + "(" + v(z) + ", " + v(x) + ", " + v(y) + ", gap);";
+}
+
+const string to_literal(double value) {
+
+	ostringstream os;
+
+	os << setprecision(17) << value;
+
+	const string s = os.str();
+
+	// Make sure it is a double literal, e.g. 1 -> 1.0
+	return (s.find_first_of(".eEni") == string::npos) ? s + ".0" : s;
+}
+
+}
+
+namespace asol {
+
+code_generator::code_generator(const problem_data* problem, const string& name_of_problem) :
+
+	name(name_of_problem),
+	n_vars(problem->number_of_variables()),
+	n_nodes(problem->peek_index()),
+	constants(problem->get_numeric_constants().begin(), problem->get_numeric_constants().end())
+{
+	const problem_data::VecPrimitive& primitives = problem->get_primitives();
+
+	forward_sweep.reserve(primitives.size());
+
+	backward_sweep.reserve(primitives.size());
+
+	for (size_t i=0; i<primitives.size(); ++i) {
+
+		primitives.at(i)->record(this);
+	}
+}
+
+code_generator::~code_generator() {
+	// Out-of-line dtor just to make the compiler shut up
+}
+
+void code_generator::addition(int z, int x, int y) {
+
+	forward_sweep.push_back(call("add", z, x, y));
+
+	backward_sweep.push_back(call("addition_inverse", z, x, y));
+}
+
+void code_generator::substraction(int z, int x, int y) {
+
+	forward_sweep.push_back(call("sub", z, x, y));
+
+	backward_sweep.push_back(call("substraction_inverse", z, x, y));
+}
+
+void code_generator::multiplication(int z, int x, int y) {
+
+	forward_sweep.push_back(call("mul", z, x, y));
+
+	// y = z/x, then x = z/y, then z = x*y; the gaps are not used
+	backward_sweep.push_back(call_with_gap("extended_division", z, x, y) + "\n\t" +
+                             call_with_gap("extended_division", z, y, x) + "\n\t" +
+                             call("mul", z, x, y));
+}
+
+void code_generator::division(int z, int x, int y) {
+
+	forward_sweep.push_back(call("div", z, x, y));
+
+	backward_sweep.push_back(call_with_gap("division_inverse", z, x, y));
+}
+
+void code_generator::square(int z, int x) {
+
+	forward_sweep.push_back(call("sqr", z, x));
+
+	backward_sweep.push_back(call_with_gap("sqr_inverse", z, x));
+}
+
+void code_generator::exponential(int z, int x) {
+
+	forward_sweep.push_back(call("exp", z, x));
+
+	backward_sweep.push_back(call("exp_inverse", z, x));
+}
+
+void code_generator::logarithm(int z, int x) {
+
+	forward_sweep.push_back(call("log", z, x));
+
+	backward_sweep.push_back(call("log_inverse", z, x));
+}
+
+void code_generator::equality_constraint(int z, int , double val) {
+
+	const string rhs = to_literal(val);
+
+	forward_sweep.push_back(v(z) + ".equals(" + rhs + ");");
+
+	backward_sweep.push_back("equality_constraint_inverse(" + v(z) + ", " + rhs + ");");
+}
+
+void code_generator::common_subexpression(int , int ) {
+	// TODO Not clear what to do, same as in the primitives
+}
+
+void code_generator::less_than_or_equal_to(int z, int x) {
+
+	const string line = v(z) + ".less_than_or_equal_to(" + v(x) + ");";
+
+	forward_sweep.push_back(line);
+
+	backward_sweep.push_back(line);
+}
+
+const string code_generator::kernel_namespace() const {
+
+	return name + "_kernel";
+}
+
+const string code_generator::guard() const {
+
+	string result = kernel_namespace() + "_HPP_";
+
+	for (size_t i=0; i<result.size(); ++i) {
+
+		result.at(i) = toupper(result.at(i));
+	}
+
+	return result;
+}
+
+void code_generator::write_header(ostream& out) const {
+
+	out << "// Generated by asol::code_generator from " << name << ", do not edit\n\n";
+
+	out << "#ifndef " << guard() << '\n';
+	out << "#define " << guard() << "\n\n";
+
+	out << "namespace asol {\n\n";
+
+	out << "class interval;\n\n";
+
+	out << "namespace " << kernel_namespace() << " {\n\n";
+
+	out << "const int NUMBER_OF_VARIABLES = " << n_vars << ";\n\n";
+
+	out << "const int NUMBER_OF_NODES = " << n_nodes << ";\n\n";
+
+	out << "// v must have NUMBER_OF_NODES elements, box NUMBER_OF_VARIABLES\n";
+	out << "void set_box(interval* v, const interval* box);\n\n";
+
+	out << "// For affine, v must be set up as in expression_graph<affine>\n";
+	out << "template <typename T>\n";
+	out << "void evaluate(T* v);\n\n";
+
+	out << "void revise(interval* v);\n\n";
+
+	out << "}\n\n";
+
+	out << "}\n\n";
+
+	out << "#endif // " << guard() << '\n';
+}
+
+void code_generator::write_source(ostream& out) const {
+
+	out << "// Generated by asol::code_generator from " << name << ", do not edit\n\n";
+
+	out << "#include \"" << kernel_namespace() << ".hpp\"\n";
+
+	out << "#include \"evaluate.hpp\"\n\n";
+
+	out << "namespace asol {\n\n";
+
+	out << "namespace " << kernel_namespace() << " {\n\n";
+
+	write_set_box(out);
+
+	write_evaluate(out);
+
+	write_revise(out);
+
+	out << "}\n\n";
+
+	out << "}\n";
+}
+
+void code_generator::write_set_box(ostream& out) const {
+
+	out << "void set_box(interval* v, const interval* box) {\n\n";
+
+	out << "\tfor (int i=0; i<NUMBER_OF_VARIABLES; ++i) {\n\n";
+	out << "\t\tv[i] = box[i];\n";
+	out << "\t}\n\n";
+
+	out << "\tfor (int i=NUMBER_OF_VARIABLES; i<NUMBER_OF_NODES; ++i) {\n\n";
+	out << "\t\tv[i] = interval::ANY_REAL();\n";
+	out << "\t}\n\n";
+
+	for (size_t i=0; i<constants.size(); ++i) {
+
+		out << '\t' << v(constants.at(i).first) << " = interval(" << to_literal(constants.at(i).second) << ");\n";
+	}
+
+	out << "}\n\n";
+}
+
+void code_generator::write_evaluate(ostream& out) const {
+
+	out << "template <typename T>\n";
+	out << "void evaluate(T* v) {\n\n";
+
+	for (size_t i=0; i<forward_sweep.size(); ++i) {
+
+		out << '\t' << forward_sweep.at(i) << '\n';
+	}
+
+	out << "}\n\n";
+
+	out << "template void evaluate<interval>(interval* v);\n\n";
+
+	out << "template void evaluate<affine>(affine* v);\n\n";
+}
+
+void code_generator::write_revise(ostream& out) const {
+
+	out << "void revise(interval* v) {\n\n";
+
+	out << "\tinterval gap;\n\n";
+
+	for (size_t i=backward_sweep.size(); i>0; --i) {
+
+		out << '\t' << backward_sweep.at(i-1) << '\n';
+	}
+
+	out << "}\n\n";
+}
+
+void code_generator::write_files(const string& directory) const {
+
+	const string base = directory + "/" + kernel_namespace();
+
+	ofstream header, source;
+
+	header.exceptions(ios_base::failbit | ios_base::badbit);
+
+	source.exceptions(ios_base::failbit | ios_base::badbit);
+
+	header.open((base + ".hpp").c_str());
+
+	write_header(header);
+
+	source.open((base + ".cpp").c_str());
+
+	write_source(source);
+}
+
+}
@@ -0,0 +1,181 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <iostream>
+#include <sys/time.h>
+#include "contractor_scheduler.hpp"
+#include "diagnostics.hpp"
+
+using std::cout;
+using std::endl;
+
+namespace {
+
+const double MIN_ELAPSED_MS = 1.0e-3; // below the resolution of the clock
+
+double milliseconds() {
+
+	timeval t;
+
+	gettimeofday(&t, 0);
+
+	return t.tv_sec*1.0e+3 + t.tv_usec*1.0e-3;
+}
+
+}
+
+namespace asol {
+
+scheduling_options::scheduling_options()
+: policy(LP_ALWAYS),
+  sufficient_reduction(0.95),
+  min_gain_per_ms(0.05),
+  warm_up(4),
+  probe_interval(8),
+  decay(0.25)
+{
+
+}
+
+contractor_scheduler::depth_stats::depth_stats() : skipped(0), skip_streak(0) {
+
+	for (int c=0; c<N_CONTRACTORS; ++c) {
+
+		samples[c] = 0;
+
+		gain_per_ms[c] = total_gain[c] = total_ms[c] = 0.0;
+	}
+}
+
+contractor_scheduler::contractor_scheduler(const scheduling_options& opts) : options(opts) {
+
+	ASSERT2(0 < options.decay && options.decay <= 1, "decay: "<<options.decay);
+
+	ASSERT2(options.probe_interval > 0, "probe interval: "<<options.probe_interval);
+
+	std::fill(start_time, start_time+N_CONTRACTORS, 0.0);
+}
+
+contractor_scheduler::depth_stats& contractor_scheduler::at(int depth) {
+
+	ASSERT2(depth >= 0, "depth: "<<depth);
+
+	if (depth >= static_cast<int>(stats.size())) {
+
+		stats.resize(depth+1);
+	}
+
+	return stats.at(depth);
+}
+
+bool contractor_scheduler::run_lp_stage(int depth) {
+
+	if (options.policy != LP_ADAPTIVE) {
+
+		return options.policy == LP_ALWAYS;
+	}
+
+	depth_stats& s = at(depth);
+
+	if (s.samples[LP_STAGE] < options.warm_up || s.gain_per_ms[LP_STAGE] >= options.min_gain_per_ms) {
+
+		return true;
+	}
+
+	if (++s.skip_streak == options.probe_interval) {
+
+		s.skip_streak = 0;
+
+		return true;
+	}
+
+	++s.skipped;
+
+	return false;
+}
+
+void contractor_scheduler::start(contractor c) {
+
+	start_time[c] = milliseconds();
+}
+
+void contractor_scheduler::finish(contractor c, int depth, double reduction) {
+
+	const double elapsed = std::max(milliseconds() - start_time[c], MIN_ELAPSED_MS);
+
+	const double gain = 1.0 - std::min(std::max(reduction, 0.0), 1.0);
+
+	depth_stats& s = at(depth);
+
+	const double rate = gain / elapsed;
+
+	s.gain_per_ms[c] = s.samples[c] ? (1-options.decay)*s.gain_per_ms[c] + options.decay*rate : rate;
+
+	++s.samples[c];
+
+	s.total_gain[c] += gain;
+
+	s.total_ms[c] += elapsed;
+}
+
+void contractor_scheduler::excellent_progress(int depth) {
+
+	depth_stats& s = at(depth);
+
+	s.gain_per_ms[LP_STAGE] = std::max(s.gain_per_ms[LP_STAGE], options.min_gain_per_ms);
+
+	s.skip_streak = 0;
+}
+
+bool contractor_scheduler::sufficient(double reduction) const {
+
+	return reduction < options.sufficient_reduction;
+}
+
+void contractor_scheduler::print_statistics() const {
+
+	cout << "Depth, IA runs, gain/ms, Newton runs, gain/ms, LP runs, gain/ms, LP skipped" << endl;
+
+	for (int depth=0; depth<static_cast<int>(stats.size()); ++depth) {
+
+		const depth_stats& s = stats.at(depth);
+
+		if (s.samples[IA_REVISION]==0) {
+
+			continue;
+		}
+
+		cout << depth;
+
+		for (int c=0; c<N_CONTRACTORS; ++c) {
+
+			const double rate = s.total_ms[c] ? s.total_gain[c]/s.total_ms[c] : 0.0;
+
+			cout << ", " << s.samples[c] << ", " << rate;
+		}
+
+		cout << ", " << s.skipped << endl;
+	}
+}
+
+}
@@ -28,6 +28,7 @@
 #include "interval.hpp"
 #include "primitives.hpp"
 #include "recorder.hpp"
+#include "tape.hpp"
 
 using namespace std;
 
@@ -129,6 +130,102 @@ const vector<primitive<T>*> convert(const Vector& vec) {
 	return conv.result();
 }
 
+class tape_converter : public recorder {
+
+public:
+
+	tape_converter(const Vector& vec) {
+
+		tape.reserve(vec.size());
+
+		for_each(vec.begin(), vec.end(), bind2nd(mem_fun(&Primitive::record), this));
+	}
+
+	const vector<tape_record>& result() const {
+
+		return tape;
+	}
+
+	~tape_converter();
+
+private:
+
+	tape_converter(const tape_converter& );
+	tape_converter& operator=(const tape_converter& );
+
+	void push_back(int op, int z, int x, int y, double rhs) {
+
+		tape_record r = { op, z, x, y, rhs };
+
+		tape.push_back(r);
+	}
+
+	virtual void addition(int z, int x, int y) {
+
+		push_back(OP_ADD, z, x, y, 0.0);
+	}
+
+	virtual void substraction(int z, int x, int y) {
+
+		push_back(OP_SUB, z, x, y, 0.0);
+	}
+
+	virtual void multiplication(int z, int x, int y) {
+
+		push_back(OP_MUL, z, x, y, 0.0);
+	}
+
+	virtual void division(int z, int x, int y) {
+
+		push_back(OP_DIV, z, x, y, 0.0);
+	}
+
+	virtual void square(int z, int x) {
+
+		push_back(OP_SQR, z, x, -1, 0.0);
+	}
+
+	virtual void exponential(int z, int x) {
+
+		push_back(OP_EXP, z, x, -1, 0.0);
+	}
+
+	virtual void logarithm(int z, int x) {
+
+		push_back(OP_LOG, z, x, -1, 0.0);
+	}
+
+	// x is the constraint offset and not an index in the DAG
+	virtual void equality_constraint(int z, int , double val) {
+
+		push_back(OP_EQUALITY, z, -1, -1, val);
+	}
+
+	// x is the ordinal and not an index in the DAG
+	virtual void common_subexpression(int z, int ) {
+
+		push_back(OP_CSE, z, -1, -1, 0.0);
+	}
+
+	virtual void less_than_or_equal_to(int z, int x) {
+
+		push_back(OP_LESS_EQ, z, x, -1, 0.0);
+	}
+
+	vector<tape_record> tape;
+};
+
+tape_converter::~tape_converter() {
+	// Dtor is out-of-line to make the compiler shut-up
+}
+
+const vector<tape_record> convert_to_tape(const Vector& vec) {
+
+	tape_converter conv(vec);
+
+	return conv.result();
+}
+
 template
 const vector<primitive<interval>*> convert(const Vector& );
 
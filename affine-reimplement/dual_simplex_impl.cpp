@@ -0,0 +1,1021 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include "dual_simplex_impl.hpp"
+#include "diagnostics.hpp"
+#include "exceptions.hpp"
+
+using std::vector;
+
+namespace {
+
+const double TOL_PRIMAL = 1.0e-9;
+
+const double TOL_DUAL = 1.0e-9;
+
+const double TOL_PIVOT = 1.0e-9;
+
+const double TOL_SINGULAR = 1.0e-11;
+
+const double PERTURBATION = 1.0e-7;
+
+const int STALLING_STEPS = 10;
+
+const double TOL_COL_VAL = 1.0e-4;
+
+const double TOL_ROUNDING = 1.0e-6;
+
+const int REFACTOR_INTERVAL = 50;
+
+}
+
+namespace asol {
+
+dual_simplex_impl::dual_simplex_impl() :
+	n(0), m(0), next_row(0), factorized(false), perturbed(false), eta_count(0), sense(1.0), itr_count(0)
+{
+
+}
+
+dual_simplex_impl::~dual_simplex_impl() {
+
+}
+
+// The basis and its inverse are copied too
+dual_simplex_impl::dual_simplex_impl(const dual_simplex_impl& other) :
+	lp_impl(),
+	n(other.n), m(other.m), next_row(other.next_row),
+	A(other.A),
+	lb(other.lb), ub(other.ub), x(other.x), d(other.d), cost(other.cost), obj(other.obj),
+	status(other.status), head(other.head),
+	B_inv(other.B_inv), alpha_row(other.alpha_row), alpha_col(other.alpha_col),
+	farkas_ray(other.farkas_ray),
+	factorized(other.factorized), perturbed(other.perturbed), eta_count(other.eta_count),
+	sense(other.sense), itr_count(other.itr_count)
+{
+
+}
+
+lp_impl* dual_simplex_impl::clone() const {
+
+	return new dual_simplex_impl(*this);
+}
+
+// Fixed at zero means unset for set_col_bounds(), as for new columns
+void dual_simplex_impl::reset() {
+
+	next_row = 0;
+
+	for (int j=0; j<n; ++j) {
+
+		lb.at(j) = ub.at(j) = 0.0;
+	}
+}
+
+void dual_simplex_impl::add_cols(int n_cols) {
+
+	ASSERT2(n_cols>0 && n==0 && m==0, "n_cols, n, m: "<<n_cols<<", "<<n<<", "<<m);
+
+	n = n_cols;
+
+	lb.assign(n, 0.0);
+	ub.assign(n, 0.0);
+	x.assign(n, 0.0);
+	d.assign(n, 0.0);
+	cost.assign(n, 0.0);
+
+	status.assign(n, AT_LB);
+
+	alpha_row.assign(n, 0.0);
+}
+
+// The row activity becomes a basic variable if the row is appended,
+// the enlarged basis remains nonsingular
+void dual_simplex_impl::add_eq_row(const int index[], const double value[], int length, double l, double u) {
+
+	ASSERT2(n > 0, "columns must be added first");
+
+	ASSERT2(l <= u, "lb, ub: "<<l<<", "<<u);
+
+	const int i = next_row;
+
+	if (i == m) {
+
+		A.resize((m+1)*n, 0.0);
+
+		lb.push_back(0.0);
+		ub.push_back(0.0);
+		x.push_back(0.0);
+		d.push_back(0.0);
+		cost.push_back(0.0);
+
+		status.push_back(IN_BASIS);
+
+		alpha_row.push_back(0.0);
+
+		head.push_back(n+m);
+
+		++m;
+	}
+	else {
+
+		std::fill(A.begin()+i*n, A.begin()+(i+1)*n, 0.0);
+	}
+
+	for (int k=1; k<=length; ++k) {
+
+		const int j = index[k] - 1;
+
+		ASSERT2(0<=j && j<n, "j: "<<j);
+
+		A.at(i*n+j) = value[k];
+	}
+
+	lb.at(n+i) = l;
+	ub.at(n+i) = u;
+
+	++next_row;
+
+	factorized = false;
+}
+
+void dual_simplex_impl::drop_unused_rows() {
+
+	if (next_row == m) {
+
+		return;
+	}
+
+	ASSERT2(next_row < m, "next_row, m: "<<next_row<<", "<<m);
+
+	m = next_row;
+
+	A.resize(m*n);
+
+	lb.resize(n+m);
+	ub.resize(n+m);
+	x.resize(n+m);
+	d.resize(n+m);
+	cost.resize(n+m);
+
+	status.resize(n+m);
+
+	alpha_row.resize(n+m);
+
+	head.resize(m);
+
+	make_slack_basis();
+
+	factorized = false;
+}
+
+void dual_simplex_impl::make_slack_basis() {
+
+	for (int j=0; j<n; ++j) {
+
+		if (status.at(j) == IN_BASIS) {
+
+			status.at(j) = AT_LB;
+		}
+	}
+
+	for (int i=0; i<m; ++i) {
+
+		status.at(n+i) = IN_BASIS;
+
+		head.at(i) = n+i;
+	}
+}
+
+void dual_simplex_impl::set_col_bounds(int index, double l, double u) {
+
+	check_col_index(index);
+
+	ASSERT(l < u);
+
+	const int j = index - 1;
+
+	if (lb.at(j)!=0 && ub.at(j)!=0) { // if bounds are set, do not set worse bounds then the existing ones
+
+		if (l < lb.at(j)) l = lb.at(j);
+
+		if (ub.at(j) < u) u = ub.at(j);
+	}
+
+	ASSERT(l < u);
+
+	lb.at(j) = l;
+	ub.at(j) = u;
+}
+
+void dual_simplex_impl::run_simplex() {
+
+	solve(0, 1.0);
+}
+
+double dual_simplex_impl::tighten_col_lb(int i, const double old_lb) {
+
+	ASSERT2(!is_fixed(i),"i: " << i);
+
+	solve(i, 1.0);
+
+	const double new_lb = col_val(i);
+
+	return (new_lb > old_lb) ? new_lb : old_lb;
+}
+
+double dual_simplex_impl::tighten_col_ub(int i, const double old_ub) {
+
+	ASSERT2(!is_fixed(i),"i: " << i);
+
+	solve(i, -1.0);
+
+	const double new_ub = col_val(i);
+
+	return (new_ub < old_ub) ? new_ub : old_ub;
+}
+
+// Minimizes direction*x_i, no objective if index is 0
+void dual_simplex_impl::solve(int index, double direction) {
+
+	drop_unused_rows();
+
+	std::fill(cost.begin(), cost.end(), 0.0);
+
+	if (index > 0) {
+
+		check_col_index(index);
+
+		cost.at(index-1) = direction;
+	}
+
+	sense = direction;
+
+	farkas_ray.clear();
+
+	iterate();
+}
+
+// The objective of these LPs is a single column, nearly all reduced costs
+// are zero and the dual simplex may stall on degenerate steps. If it does,
+// the costs are perturbed and the iterations finished on the true costs,
+// usually without further iterations.
+void dual_simplex_impl::iterate() {
+
+	if (!factorized) {
+
+		refactor();
+	}
+
+	obj = cost;
+
+	perturbed = false;
+
+	run_dual_phase();
+
+	if (perturbed) {
+
+		obj = cost;
+
+		run_dual_phase();
+	}
+}
+
+// Pushes each nonbasic variable away from a zero reduced cost, towards its
+// current bound; the shifts differ to break the ties in the ratio test
+void dual_simplex_impl::perturb_costs() {
+
+	for (int k=0; k<n+m; ++k) {
+
+		const double shift = PERTURBATION*(1.0 + ((k*2654435761u) % 1024)/1024.0);
+
+		obj.at(k) += (status.at(k) == AT_UB) ? -shift : shift;
+	}
+
+	perturbed = true;
+}
+
+void dual_simplex_impl::run_dual_phase() {
+
+	compute_reduced_costs();
+
+	compute_basic_values();
+
+	const int max_itr = 50*(n+m) + 100;
+
+	int degenerate_steps = 0;
+
+	for (int k=0; k<max_itr; ++k) {
+
+		const int r = select_leaving_row();
+
+		if (r < 0) {
+
+			return;
+		}
+
+		const int p = head.at(r);
+
+		const double s = (x.at(p) < lb.at(p)) ? -1.0 : 1.0;
+
+		compute_pivot_row(r);
+
+		const int q = select_entering_var(s);
+
+		if (q < 0) {
+
+			farkas_ray.assign(B_inv.begin()+r*m, B_inv.begin()+(r+1)*m);
+
+			throw infeasible_problem();
+		}
+
+		compute_pivot_col(q);
+
+		const double step = pivot(r, q, s);
+
+		++itr_count;
+
+		degenerate_steps = (step == 0.0) ? degenerate_steps+1 : 0;
+
+		if (degenerate_steps > STALLING_STEPS && !perturbed) {
+
+			perturb_costs();
+
+			compute_reduced_costs();
+		}
+
+		if (eta_count >= REFACTOR_INTERVAL) {
+
+			refactor();
+
+			compute_reduced_costs();
+		}
+
+		compute_basic_values();
+	}
+
+	throw numerical_problems();
+}
+
+// Falls back to the slack basis if the kept one became singular
+void dual_simplex_impl::refactor() {
+
+	if (!factorize()) {
+
+		make_slack_basis();
+
+		if (!factorize()) {
+
+			throw numerical_problems();
+		}
+	}
+
+	factorized = true;
+
+	eta_count = 0;
+}
+
+// Gauss-Jordan elimination with partial pivoting on [B | I]
+bool dual_simplex_impl::factorize() {
+
+	vector<double> B(m*m, 0.0);
+
+	for (int c=0; c<m; ++c) {
+
+		const int k = head.at(c);
+
+		if (k < n) {
+
+			for (int i=0; i<m; ++i) {
+
+				B.at(i*m+c) = A.at(i*n+k);
+			}
+		}
+		else {
+
+			B.at((k-n)*m+c) = -1.0;
+		}
+	}
+
+	B_inv.assign(m*m, 0.0);
+
+	for (int i=0; i<m; ++i) {
+
+		B_inv.at(i*m+i) = 1.0;
+	}
+
+	for (int c=0; c<m; ++c) {
+
+		int piv_row = c;
+
+		for (int i=c+1; i<m; ++i) {
+
+			if (std::fabs(B.at(i*m+c)) > std::fabs(B.at(piv_row*m+c))) {
+
+				piv_row = i;
+			}
+		}
+
+		const double piv = B.at(piv_row*m+c);
+
+		if (std::fabs(piv) < TOL_SINGULAR) {
+
+			return false;
+		}
+
+		if (piv_row != c) {
+
+			std::swap_ranges(B.begin()+c*m, B.begin()+(c+1)*m, B.begin()+piv_row*m);
+
+			std::swap_ranges(B_inv.begin()+c*m, B_inv.begin()+(c+1)*m, B_inv.begin()+piv_row*m);
+		}
+
+		for (int j=0; j<m; ++j) {
+
+			B.at(c*m+j) /= piv;
+
+			B_inv.at(c*m+j) /= piv;
+		}
+
+		for (int i=0; i<m; ++i) {
+
+			const double f = B.at(i*m+c);
+
+			if (i == c || f == 0.0) {
+
+				continue;
+			}
+
+			for (int j=0; j<m; ++j) {
+
+				B.at(i*m+j) -= f*B.at(c*m+j);
+
+				B_inv.at(i*m+j) -= f*B_inv.at(c*m+j);
+			}
+		}
+	}
+
+	return true;
+}
+
+// d = c - [A -I]^T * B_inv^T * c_B, then the nonbasic variables are moved
+// to the bound that keeps the basis dual feasible
+void dual_simplex_impl::compute_reduced_costs() {
+
+	vector<double> y(m, 0.0);
+
+	for (int r=0; r<m; ++r) {
+
+		const double c_r = obj.at(head.at(r));
+
+		if (c_r == 0.0) {
+
+			continue;
+		}
+
+		for (int i=0; i<m; ++i) {
+
+			y.at(i) += c_r*B_inv.at(r*m+i);
+		}
+	}
+
+	for (int j=0; j<n; ++j) {
+
+		double d_j = obj.at(j);
+
+		for (int i=0; i<m; ++i) {
+
+			d_j -= y.at(i)*A.at(i*n+j);
+		}
+
+		d.at(j) = d_j;
+	}
+
+	for (int i=0; i<m; ++i) {
+
+		d.at(n+i) = obj.at(n+i) + y.at(i);
+	}
+
+	for (int k=0; k<n+m; ++k) {
+
+		if (status.at(k) == IN_BASIS) {
+
+			d.at(k) = 0.0;
+		}
+		else if (!is_boxed(k)) {
+
+			status.at(k) = AT_LB;
+		}
+		else if (d.at(k) > TOL_DUAL) {
+
+			status.at(k) = AT_LB;
+		}
+		else if (d.at(k) < -TOL_DUAL) {
+
+			status.at(k) = AT_UB;
+		}
+	}
+}
+
+// x_B = -B_inv * N * x_N
+void dual_simplex_impl::compute_basic_values() {
+
+	vector<double> w(m, 0.0);
+
+	for (int j=0; j<n; ++j) {
+
+		if (status.at(j) == IN_BASIS) {
+
+			continue;
+		}
+
+		const double x_j = x.at(j) = (status.at(j) == AT_LB) ? lb.at(j) : ub.at(j);
+
+		if (x_j == 0.0) {
+
+			continue;
+		}
+
+		for (int i=0; i<m; ++i) {
+
+			w.at(i) += A.at(i*n+j)*x_j;
+		}
+	}
+
+	for (int i=0; i<m; ++i) {
+
+		const int k = n+i;
+
+		if (status.at(k) != IN_BASIS) {
+
+			x.at(k) = (status.at(k) == AT_LB) ? lb.at(k) : ub.at(k);
+
+			w.at(i) -= x.at(k);
+		}
+	}
+
+	for (int r=0; r<m; ++r) {
+
+		double x_r = 0.0;
+
+		for (int i=0; i<m; ++i) {
+
+			x_r -= B_inv.at(r*m+i)*w.at(i);
+		}
+
+		x.at(head.at(r)) = x_r;
+	}
+}
+
+// The row of the most infeasible basic variable, -1 if primal feasible
+int dual_simplex_impl::select_leaving_row() const {
+
+	int r = -1;
+
+	double max_infeas = 0.0;
+
+	for (int i=0; i<m; ++i) {
+
+		const int k = head.at(i);
+
+		const double x_k = x.at(k);
+
+		double infeas = 0.0;
+
+		if (x_k < lb.at(k)) {
+
+			infeas = (lb.at(k) - x_k) - TOL_PRIMAL*(1.0 + std::fabs(lb.at(k)));
+		}
+		else if (x_k > ub.at(k)) {
+
+			infeas = (x_k - ub.at(k)) - TOL_PRIMAL*(1.0 + std::fabs(ub.at(k)));
+		}
+
+		if (infeas > max_infeas) {
+
+			max_infeas = infeas;
+
+			r = i;
+		}
+	}
+
+	return r;
+}
+
+void dual_simplex_impl::compute_pivot_row(int r) {
+
+	const double* const rho = &B_inv.at(r*m);
+
+	for (int j=0; j<n; ++j) {
+
+		double alpha = 0.0;
+
+		if (status.at(j) != IN_BASIS) {
+
+			for (int i=0; i<m; ++i) {
+
+				alpha += rho[i]*A.at(i*n+j);
+			}
+		}
+
+		alpha_row.at(j) = alpha;
+	}
+
+	for (int i=0; i<m; ++i) {
+
+		alpha_row.at(n+i) = (status.at(n+i) != IN_BASIS) ? -rho[i] : 0.0;
+	}
+}
+
+void dual_simplex_impl::compute_pivot_col(int q) {
+
+	alpha_col.assign(m, 0.0);
+
+	for (int r=0; r<m; ++r) {
+
+		const double* const row = &B_inv.at(r*m);
+
+		if (q < n) {
+
+			double alpha = 0.0;
+
+			for (int i=0; i<m; ++i) {
+
+				alpha += row[i]*A.at(i*n+q);
+			}
+
+			alpha_col.at(r) = alpha;
+		}
+		else {
+
+			alpha_col.at(r) = -row[q-n];
+		}
+	}
+}
+
+// Harris' two-pass ratio test: the first pass finds the largest step that
+// keeps each reduced cost within the tolerance, the second one picks the
+// largest pivot among the candidates not beyond that step. The leaving
+// variable goes to its upper bound if s is 1, to its lower bound if s is -1.
+int dual_simplex_impl::select_entering_var(double s) const {
+
+	double max_step = std::numeric_limits<double>::max();
+
+	for (int k=0; k<n+m; ++k) {
+
+		if (status.at(k) == IN_BASIS || !is_boxed(k)) {
+
+			continue;
+		}
+
+		const double a = s*alpha_row.at(k);
+
+		if (status.at(k) == AT_LB && a > TOL_PIVOT) {
+
+			max_step = std::min(max_step, (std::max(d.at(k), 0.0) + TOL_DUAL)/a);
+		}
+		else if (status.at(k) == AT_UB && a < -TOL_PIVOT) {
+
+			max_step = std::min(max_step, (std::min(d.at(k), 0.0) - TOL_DUAL)/a);
+		}
+	}
+
+	int q = -1;
+
+	double max_pivot = 0.0;
+
+	for (int k=0; k<n+m; ++k) {
+
+		if (status.at(k) == IN_BASIS || !is_boxed(k)) {
+
+			continue;
+		}
+
+		const double a = s*alpha_row.at(k);
+
+		double step = 0.0;
+
+		if (status.at(k) == AT_LB && a > TOL_PIVOT) {
+
+			step = std::max(d.at(k), 0.0)/a;
+		}
+		else if (status.at(k) == AT_UB && a < -TOL_PIVOT) {
+
+			step = std::min(d.at(k), 0.0)/a;
+		}
+		else {
+
+			continue;
+		}
+
+		if (step <= max_step && std::fabs(a) > max_pivot) {
+
+			max_pivot = std::fabs(a);
+
+			q = k;
+		}
+	}
+
+	return q;
+}
+
+// Basis change with the dual step t, which is returned; a nonbasic variable
+// whose reduced cost drifted beyond the tolerance is flipped to its other bound
+double dual_simplex_impl::pivot(int r, int q, double s) {
+
+	const double piv = alpha_col.at(r);
+
+	if (std::fabs(piv) < TOL_PIVOT) {
+
+		throw numerical_problems();
+	}
+
+	const int p = head.at(r);
+
+	const double a_q = s*alpha_row.at(q);
+
+	const double t = ((status.at(q) == AT_LB) ? std::max(d.at(q), 0.0) : std::min(d.at(q), 0.0))/a_q;
+
+	for (int k=0; k<n+m; ++k) {
+
+		if (status.at(k) != IN_BASIS) {
+
+			d.at(k) -= s*t*alpha_row.at(k);
+		}
+	}
+
+	d.at(q) = 0.0;
+
+	d.at(p) = -s*t;
+
+	status.at(q) = IN_BASIS;
+
+	status.at(p) = (s < 0) ? AT_LB : AT_UB;
+
+	head.at(r) = q;
+
+	for (int k=0; k<n+m; ++k) {
+
+		if (status.at(k) == AT_LB && d.at(k) < -TOL_DUAL && is_boxed(k)) {
+
+			status.at(k) = AT_UB;
+		}
+		else if (status.at(k) == AT_UB && d.at(k) > TOL_DUAL) {
+
+			status.at(k) = AT_LB;
+		}
+	}
+
+	double* const row_r = &B_inv.at(r*m);
+
+	for (int j=0; j<m; ++j) {
+
+		row_r[j] /= piv;
+	}
+
+	for (int i=0; i<m; ++i) {
+
+		const double f = alpha_col.at(i);
+
+		if (i == r || f == 0.0) {
+
+			continue;
+		}
+
+		double* const row_i = &B_inv.at(i*m);
+
+		for (int j=0; j<m; ++j) {
+
+			row_i[j] -= f*row_r[j];
+		}
+	}
+
+	++eta_count;
+
+	return t;
+}
+
+bool dual_simplex_impl::is_boxed(int k) const {
+
+	return lb.at(k) < ub.at(k);
+}
+
+void dual_simplex_impl::check_col_index(int i) const {
+
+	ASSERT2(1<=i && i<=n, "i, n: "<<i<<", "<<n);
+}
+
+int dual_simplex_impl::num_cols() const {
+
+	return n;
+}
+
+int dual_simplex_impl::num_rows() const {
+
+	return next_row;
+}
+
+col_status dual_simplex_impl::col_stat(int i) const {
+
+	check_col_index(i);
+
+	const int s = status.at(i-1);
+
+	return (s == IN_BASIS) ? BASIC : ((s == AT_LB) ? NONBASIC_LB : NONBASIC_UB);
+}
+
+double dual_simplex_impl::col_val(int i) const {
+
+	check_col_index(i);
+
+	double val = x.at(i-1);
+
+	const double l = lb.at(i-1);
+
+	const double u = ub.at(i-1);
+
+	if ((val+TOL_COL_VAL < l) || (val > u+TOL_COL_VAL)) {
+
+		throw numerical_problems();
+	}
+
+	if (val < l) {
+
+		val = l;
+	}
+	else if (val > u) {
+
+		val = u;
+	}
+
+	return val;
+}
+
+double dual_simplex_impl::col_lb(int i) const {
+
+	check_col_index(i);
+
+	return lb.at(i-1);
+}
+
+double dual_simplex_impl::col_ub(int i) const {
+
+	check_col_index(i);
+
+	return ub.at(i-1);
+}
+
+// Same sign convention as GLPK: nonnegative at the lower bound when
+// minimizing, nonpositive when maximizing
+double dual_simplex_impl::col_dual_val(int i) const {
+
+	check_col_index(i);
+
+	return sense*d.at(i-1);
+}
+
+// The reduced cost of the row activity is the dual value of the row
+double dual_simplex_impl::row_dual_val(int i) const {
+
+	ASSERT2(1<=i && i<=next_row, "i, rows: "<<i<<", "<<next_row);
+
+	return sense*d.at(n+i-1);
+}
+
+bool dual_simplex_impl::infeasibility_certificate(vector<double>& y) const {
+
+	if (farkas_ray.empty()) {
+
+		return false;
+	}
+
+	y = farkas_ray;
+
+	return true;
+}
+
+bool dual_simplex_impl::has_reduced_costs() const {
+
+	return true;
+}
+
+// The Harris ratio test lets the basic variables cross their bounds within
+// the tolerances, an optimum found earlier may be missed by a few ulps
+double dual_simplex_impl::primal_tolerance() const {
+
+	return TOL_ROUNDING;
+}
+
+const sparse_rows* dual_simplex_impl::recorded_rows() const {
+
+	return 0;
+}
+
+bool dual_simplex_impl::is_fixed(int index) const {
+
+	check_col_index(index);
+
+	return !is_boxed(index-1);
+}
+
+void dual_simplex_impl::dump(const char* file) const {
+
+	std::ofstream out(file);
+
+	out.precision(17);
+
+	out << "Rows: " << next_row << ", columns: " << n << '\n';
+
+	for (int i=0; i<next_row; ++i) {
+
+		out << "r" << i+1 << ": " << lb.at(n+i) << " <= ";
+
+		for (int j=0; j<n; ++j) {
+
+			const double a_ij = A.at(i*n+j);
+
+			if (a_ij != 0.0) {
+
+				out << " + " << a_ij << " x" << j+1;
+			}
+		}
+
+		out << " <= " << ub.at(n+i) << '\n';
+	}
+
+	for (int j=0; j<n; ++j) {
+
+		out << lb.at(j) << " <= x" << j+1 << " <= " << ub.at(j) << '\n';
+	}
+}
+
+void dual_simplex_impl::show_iteration_count() const {
+
+	std::cout << "Simplex iterations: " << itr_count << std::endl;
+}
+
+uint64_t dual_simplex_impl::iteration_count() const {
+
+	return itr_count;
+}
+
+// One status for each column and row activity
+void dual_simplex_impl::save_basis(lp_basis& basis) const {
+
+	basis.status = status;
+
+	basis.point.clear();
+}
+
+void dual_simplex_impl::load_basis(const lp_basis& basis) {
+
+	drop_unused_rows();
+
+	if (static_cast<int>(basis.status.size()) != n+m) {
+
+		return;
+	}
+
+	if (std::count(basis.status.begin(), basis.status.end(), static_cast<int>(IN_BASIS)) != m) {
+
+		return;
+	}
+
+	status = basis.status;
+
+	for (int k=0, r=0; k<n+m; ++k) {
+
+		if (status.at(k) == IN_BASIS) {
+
+			head.at(r++) = k;
+		}
+	}
+
+	factorized = false;
+}
+
+}
@@ -0,0 +1,679 @@
+// Generated by asol::code_generator from Jacobsen, do not edit
+
+#include "Jacobsen_kernel.hpp"
+#include "evaluate.hpp"
+
+namespace asol {
+
+namespace Jacobsen_kernel {
+
+void set_box(interval* v, const interval* box) {
+
+	for (int i=0; i<NUMBER_OF_VARIABLES; ++i) {
+
+		v[i] = box[i];
+	}
+
+	for (int i=NUMBER_OF_VARIABLES; i<NUMBER_OF_NODES; ++i) {
+
+		v[i] = interval::ANY_REAL();
+	}
+
+	v[16] = interval(1.0);
+	v[18] = interval(2.5499999999999998);
+	v[20] = interval(3.5499999999999998);
+	v[23] = interval(0.28060000000000002);
+	v[25] = interval(0.60099999999999998);
+	v[29] = interval(1.0);
+	v[33] = interval(4.0);
+	v[35] = interval(1.0);
+	v[37] = interval(2.5499999999999998);
+	v[39] = interval(3.5499999999999998);
+	v[42] = interval(3.0);
+	v[46] = interval(-0.087999999999999995);
+	v[49] = interval(0.43969999999999998);
+	v[51] = interval(-3.98);
+	v[54] = interval(0.13489999999999999);
+	v[57] = interval(-1.087);
+	v[60] = interval(0.16669999999999999);
+	v[66] = interval(-0.087999999999999995);
+	v[69] = interval(0.43969999999999998);
+	v[71] = interval(-3.98);
+	v[74] = interval(0.13489999999999999);
+	v[77] = interval(-1.087);
+	v[80] = interval(0.16669999999999999);
+	v[83] = interval(3.0);
+	v[88] = interval(1.0);
+	v[90] = interval(2.5499999999999998);
+	v[92] = interval(3.5499999999999998);
+	v[98] = interval(-0.087999999999999995);
+	v[101] = interval(0.43969999999999998);
+	v[103] = interval(-3.98);
+	v[106] = interval(0.13489999999999999);
+	v[109] = interval(-1.087);
+	v[112] = interval(0.16669999999999999);
+	v[118] = interval(1.0);
+	v[121] = interval(1.0);
+	v[123] = interval(2.5499999999999998);
+	v[125] = interval(3.5499999999999998);
+	v[131] = interval(-0.087999999999999995);
+	v[134] = interval(0.43969999999999998);
+	v[136] = interval(-3.98);
+	v[139] = interval(0.13489999999999999);
+	v[142] = interval(-1.087);
+	v[145] = interval(0.16669999999999999);
+	v[152] = interval(1.0);
+	v[154] = interval(2.5499999999999998);
+	v[156] = interval(3.5499999999999998);
+	v[162] = interval(-0.087999999999999995);
+	v[165] = interval(0.43969999999999998);
+	v[167] = interval(-3.98);
+	v[170] = interval(0.13489999999999999);
+	v[173] = interval(-1.087);
+	v[176] = interval(0.16669999999999999);
+	v[182] = interval(1.0);
+	v[185] = interval(1.0);
+	v[187] = interval(2.5499999999999998);
+	v[189] = interval(3.5499999999999998);
+	v[195] = interval(-0.087999999999999995);
+	v[198] = interval(0.43969999999999998);
+	v[200] = interval(-3.98);
+	v[203] = interval(0.13489999999999999);
+	v[206] = interval(-1.087);
+	v[209] = interval(0.16669999999999999);
+	v[216] = interval(1.0);
+	v[218] = interval(2.5499999999999998);
+	v[220] = interval(3.5499999999999998);
+	v[226] = interval(-0.087999999999999995);
+	v[229] = interval(0.43969999999999998);
+	v[231] = interval(-3.98);
+	v[234] = interval(0.13489999999999999);
+	v[237] = interval(-1.087);
+	v[240] = interval(0.16669999999999999);
+	v[247] = interval(1.0);
+	v[249] = interval(2.5499999999999998);
+	v[251] = interval(3.5499999999999998);
+	v[257] = interval(-0.087999999999999995);
+	v[260] = interval(0.43969999999999998);
+	v[262] = interval(-3.98);
+	v[265] = interval(0.13489999999999999);
+	v[268] = interval(-1.087);
+	v[271] = interval(0.16669999999999999);
+}
+
+template <typename T>
+void evaluate(T* v) {
+
+	div(v[17], v[16], v[0]);
+	add(v[19], v[17], v[18]);
+	div(v[21], v[20], v[19]);
+	mul(v[22], v[15], v[21]);
+	mul(v[24], v[23], v[21]);
+	sub(v[26], v[25], v[24]);
+	sub(v[27], v[8], v[15]);
+	mul(v[28], v[27], v[26]);
+	v[28].equals(0.95999999999999996);
+	sub(v[30], v[29], v[15]);
+	mul(v[31], v[30], v[7]);
+	add(v[32], v[31], v[22]);
+	v[32].equals(0.5);
+	sub(v[34], v[33], v[15]);
+	div(v[36], v[35], v[7]);
+	add(v[38], v[36], v[37]);
+	div(v[40], v[39], v[38]);
+	mul(v[41], v[34], v[6]);
+	mul(v[43], v[42], v[40]);
+	sub(v[44], v[43], v[41]);
+	sub(v[45], v[44], v[22]);
+	v[45].equals(-0.5);
+	mul(v[47], v[46], v[0]);
+	exp(v[48], v[47]);
+	mul(v[50], v[49], v[48]);
+	mul(v[52], v[51], v[0]);
+	exp(v[53], v[52]);
+	mul(v[55], v[54], v[53]);
+	add(v[56], v[55], v[50]);
+	mul(v[58], v[57], v[21]);
+	exp(v[59], v[58]);
+	mul(v[61], v[60], v[59]);
+	mul(v[62], v[15], v[61]);
+	sub(v[63], v[56], v[61]);
+	mul(v[64], v[8], v[63]);
+	add(v[65], v[64], v[62]);
+	mul(v[67], v[66], v[7]);
+	exp(v[68], v[67]);
+	mul(v[70], v[69], v[68]);
+	mul(v[72], v[71], v[7]);
+	exp(v[73], v[72]);
+	mul(v[75], v[74], v[73]);
+	add(v[76], v[75], v[70]);
+	mul(v[78], v[77], v[6]);
+	exp(v[79], v[78]);
+	mul(v[81], v[80], v[79]);
+	mul(v[82], v[34], v[81]);
+	mul(v[84], v[83], v[76]);
+	sub(v[85], v[84], v[82]);
+	sub(v[86], v[85], v[65]);
+	v[86].equals(-0.096804699999999994);
+	sub(v[87], v[9], v[15]);
+	div(v[89], v[88], v[1]);
+	add(v[91], v[89], v[90]);
+	div(v[93], v[92], v[91]);
+	mul(v[94], v[87], v[0]);
+	mul(v[95], v[9], v[93]);
+	sub(v[96], v[95], v[94]);
+	sub(v[97], v[96], v[22]);
+	v[97].equals(0.0);
+	mul(v[99], v[98], v[1]);
+	exp(v[100], v[99]);
+	mul(v[102], v[101], v[100]);
+	mul(v[104], v[103], v[1]);
+	exp(v[105], v[104]);
+	mul(v[107], v[106], v[105]);
+	add(v[108], v[107], v[102]);
+	mul(v[110], v[109], v[0]);
+	exp(v[111], v[110]);
+	mul(v[113], v[112], v[111]);
+	mul(v[114], v[87], v[113]);
+	mul(v[115], v[9], v[108]);
+	sub(v[116], v[115], v[114]);
+	sub(v[117], v[116], v[65]);
+	v[117].equals(0.0);
+	add(v[119], v[14], v[118]);
+	sub(v[120], v[119], v[15]);
+	div(v[122], v[121], v[6]);
+	add(v[124], v[122], v[123]);
+	div(v[126], v[125], v[124]);
+	mul(v[127], v[120], v[5]);
+	mul(v[128], v[14], v[126]);
+	sub(v[129], v[128], v[127]);
+	sub(v[130], v[129], v[22]);
+	v[130].equals(-0.5);
+	mul(v[132], v[131], v[6]);
+	exp(v[133], v[132]);
+	mul(v[135], v[134], v[133]);
+	mul(v[137], v[136], v[6]);
+	exp(v[138], v[137]);
+	mul(v[140], v[139], v[138]);
+	add(v[141], v[140], v[135]);
+	mul(v[143], v[142], v[5]);
+	exp(v[144], v[143]);
+	mul(v[146], v[145], v[144]);
+	mul(v[147], v[120], v[146]);
+	mul(v[148], v[14], v[141]);
+	sub(v[149], v[148], v[147]);
+	sub(v[150], v[149], v[65]);
+	v[150].equals(-0.096804699999999994);
+	sub(v[151], v[10], v[15]);
+	div(v[153], v[152], v[2]);
+	add(v[155], v[153], v[154]);
+	div(v[157], v[156], v[155]);
+	mul(v[158], v[151], v[1]);
+	mul(v[159], v[10], v[157]);
+	sub(v[160], v[159], v[158]);
+	sub(v[161], v[160], v[22]);
+	v[161].equals(0.0);
+	mul(v[163], v[162], v[2]);
+	exp(v[164], v[163]);
+	mul(v[166], v[165], v[164]);
+	mul(v[168], v[167], v[2]);
+	exp(v[169], v[168]);
+	mul(v[171], v[170], v[169]);
+	add(v[172], v[171], v[166]);
+	mul(v[174], v[173], v[1]);
+	exp(v[175], v[174]);
+	mul(v[177], v[176], v[175]);
+	mul(v[178], v[151], v[177]);
+	mul(v[179], v[10], v[172]);
+	sub(v[180], v[179], v[178]);
+	sub(v[181], v[180], v[65]);
+	v[181].equals(0.0);
+	add(v[183], v[13], v[182]);
+	sub(v[184], v[183], v[15]);
+	div(v[186], v[185], v[5]);
+	add(v[188], v[186], v[187]);
+	div(v[190], v[189], v[188]);
+	mul(v[191], v[184], v[4]);
+	mul(v[192], v[13], v[190]);
+	sub(v[193], v[192], v[191]);
+	sub(v[194], v[193], v[22]);
+	v[194].equals(-0.5);
+	mul(v[196], v[195], v[5]);
+	exp(v[197], v[196]);
+	mul(v[199], v[198], v[197]);
+	mul(v[201], v[200], v[5]);
+	exp(v[202], v[201]);
+	mul(v[204], v[203], v[202]);
+	add(v[205], v[204], v[199]);
+	mul(v[207], v[206], v[4]);
+	exp(v[208], v[207]);
+	mul(v[210], v[209], v[208]);
+	mul(v[211], v[184], v[210]);
+	mul(v[212], v[13], v[205]);
+	sub(v[213], v[212], v[211]);
+	sub(v[214], v[213], v[65]);
+	v[214].equals(-0.096804699999999994);
+	sub(v[215], v[11], v[15]);
+	div(v[217], v[216], v[3]);
+	add(v[219], v[217], v[218]);
+	div(v[221], v[220], v[219]);
+	mul(v[222], v[215], v[2]);
+	mul(v[223], v[11], v[221]);
+	sub(v[224], v[223], v[222]);
+	sub(v[225], v[224], v[22]);
+	v[225].equals(0.0);
+	mul(v[227], v[226], v[3]);
+	exp(v[228], v[227]);
+	mul(v[230], v[229], v[228]);
+	mul(v[232], v[231], v[3]);
+	exp(v[233], v[232]);
+	mul(v[235], v[234], v[233]);
+	add(v[236], v[235], v[230]);
+	mul(v[238], v[237], v[2]);
+	exp(v[239], v[238]);
+	mul(v[241], v[240], v[239]);
+	mul(v[242], v[215], v[241]);
+	mul(v[243], v[11], v[236]);
+	sub(v[244], v[243], v[242]);
+	sub(v[245], v[244], v[65]);
+	v[245].equals(0.0);
+	sub(v[246], v[12], v[15]);
+	div(v[248], v[247], v[4]);
+	add(v[250], v[248], v[249]);
+	div(v[252], v[251], v[250]);
+	mul(v[253], v[246], v[3]);
+	mul(v[254], v[12], v[252]);
+	sub(v[255], v[254], v[253]);
+	sub(v[256], v[255], v[22]);
+	v[256].equals(0.0);
+	mul(v[258], v[257], v[4]);
+	exp(v[259], v[258]);
+	mul(v[261], v[260], v[259]);
+	mul(v[263], v[262], v[4]);
+	exp(v[264], v[263]);
+	mul(v[266], v[265], v[264]);
+	add(v[267], v[266], v[261]);
+	mul(v[269], v[268], v[3]);
+	exp(v[270], v[269]);
+	mul(v[272], v[271], v[270]);
+	mul(v[273], v[246], v[272]);
+	mul(v[274], v[12], v[267]);
+	sub(v[275], v[274], v[273]);
+	sub(v[276], v[275], v[65]);
+	v[276].equals(0.0);
+}
+
+template void evaluate<interval>(interval* v);
+
+template void evaluate<affine>(affine* v);
+
+void revise(interval* v) {
+
+	interval gap;
+
+	equality_constraint_inverse(v[276], 0.0);
+	substraction_inverse(v[276], v[275], v[65]);
+	substraction_inverse(v[275], v[274], v[273]);
+	extended_division(v[274], v[12], v[267], gap);
+	extended_division(v[274], v[267], v[12], gap);
+	mul(v[274], v[12], v[267]);
+	extended_division(v[273], v[246], v[272], gap);
+	extended_division(v[273], v[272], v[246], gap);
+	mul(v[273], v[246], v[272]);
+	extended_division(v[272], v[271], v[270], gap);
+	extended_division(v[272], v[270], v[271], gap);
+	mul(v[272], v[271], v[270]);
+	exp_inverse(v[270], v[269]);
+	extended_division(v[269], v[268], v[3], gap);
+	extended_division(v[269], v[3], v[268], gap);
+	mul(v[269], v[268], v[3]);
+	addition_inverse(v[267], v[266], v[261]);
+	extended_division(v[266], v[265], v[264], gap);
+	extended_division(v[266], v[264], v[265], gap);
+	mul(v[266], v[265], v[264]);
+	exp_inverse(v[264], v[263]);
+	extended_division(v[263], v[262], v[4], gap);
+	extended_division(v[263], v[4], v[262], gap);
+	mul(v[263], v[262], v[4]);
+	extended_division(v[261], v[260], v[259], gap);
+	extended_division(v[261], v[259], v[260], gap);
+	mul(v[261], v[260], v[259]);
+	exp_inverse(v[259], v[258]);
+	extended_division(v[258], v[257], v[4], gap);
+	extended_division(v[258], v[4], v[257], gap);
+	mul(v[258], v[257], v[4]);
+	equality_constraint_inverse(v[256], 0.0);
+	substraction_inverse(v[256], v[255], v[22]);
+	substraction_inverse(v[255], v[254], v[253]);
+	extended_division(v[254], v[12], v[252], gap);
+	extended_division(v[254], v[252], v[12], gap);
+	mul(v[254], v[12], v[252]);
+	extended_division(v[253], v[246], v[3], gap);
+	extended_division(v[253], v[3], v[246], gap);
+	mul(v[253], v[246], v[3]);
+	division_inverse(v[252], v[251], v[250], gap);
+	addition_inverse(v[250], v[248], v[249]);
+	division_inverse(v[248], v[247], v[4], gap);
+	substraction_inverse(v[246], v[12], v[15]);
+	equality_constraint_inverse(v[245], 0.0);
+	substraction_inverse(v[245], v[244], v[65]);
+	substraction_inverse(v[244], v[243], v[242]);
+	extended_division(v[243], v[11], v[236], gap);
+	extended_division(v[243], v[236], v[11], gap);
+	mul(v[243], v[11], v[236]);
+	extended_division(v[242], v[215], v[241], gap);
+	extended_division(v[242], v[241], v[215], gap);
+	mul(v[242], v[215], v[241]);
+	extended_division(v[241], v[240], v[239], gap);
+	extended_division(v[241], v[239], v[240], gap);
+	mul(v[241], v[240], v[239]);
+	exp_inverse(v[239], v[238]);
+	extended_division(v[238], v[237], v[2], gap);
+	extended_division(v[238], v[2], v[237], gap);
+	mul(v[238], v[237], v[2]);
+	addition_inverse(v[236], v[235], v[230]);
+	extended_division(v[235], v[234], v[233], gap);
+	extended_division(v[235], v[233], v[234], gap);
+	mul(v[235], v[234], v[233]);
+	exp_inverse(v[233], v[232]);
+	extended_division(v[232], v[231], v[3], gap);
+	extended_division(v[232], v[3], v[231], gap);
+	mul(v[232], v[231], v[3]);
+	extended_division(v[230], v[229], v[228], gap);
+	extended_division(v[230], v[228], v[229], gap);
+	mul(v[230], v[229], v[228]);
+	exp_inverse(v[228], v[227]);
+	extended_division(v[227], v[226], v[3], gap);
+	extended_division(v[227], v[3], v[226], gap);
+	mul(v[227], v[226], v[3]);
+	equality_constraint_inverse(v[225], 0.0);
+	substraction_inverse(v[225], v[224], v[22]);
+	substraction_inverse(v[224], v[223], v[222]);
+	extended_division(v[223], v[11], v[221], gap);
+	extended_division(v[223], v[221], v[11], gap);
+	mul(v[223], v[11], v[221]);
+	extended_division(v[222], v[215], v[2], gap);
+	extended_division(v[222], v[2], v[215], gap);
+	mul(v[222], v[215], v[2]);
+	division_inverse(v[221], v[220], v[219], gap);
+	addition_inverse(v[219], v[217], v[218]);
+	division_inverse(v[217], v[216], v[3], gap);
+	substraction_inverse(v[215], v[11], v[15]);
+	equality_constraint_inverse(v[214], -0.096804699999999994);
+	substraction_inverse(v[214], v[213], v[65]);
+	substraction_inverse(v[213], v[212], v[211]);
+	extended_division(v[212], v[13], v[205], gap);
+	extended_division(v[212], v[205], v[13], gap);
+	mul(v[212], v[13], v[205]);
+	extended_division(v[211], v[184], v[210], gap);
+	extended_division(v[211], v[210], v[184], gap);
+	mul(v[211], v[184], v[210]);
+	extended_division(v[210], v[209], v[208], gap);
+	extended_division(v[210], v[208], v[209], gap);
+	mul(v[210], v[209], v[208]);
+	exp_inverse(v[208], v[207]);
+	extended_division(v[207], v[206], v[4], gap);
+	extended_division(v[207], v[4], v[206], gap);
+	mul(v[207], v[206], v[4]);
+	addition_inverse(v[205], v[204], v[199]);
+	extended_division(v[204], v[203], v[202], gap);
+	extended_division(v[204], v[202], v[203], gap);
+	mul(v[204], v[203], v[202]);
+	exp_inverse(v[202], v[201]);
+	extended_division(v[201], v[200], v[5], gap);
+	extended_division(v[201], v[5], v[200], gap);
+	mul(v[201], v[200], v[5]);
+	extended_division(v[199], v[198], v[197], gap);
+	extended_division(v[199], v[197], v[198], gap);
+	mul(v[199], v[198], v[197]);
+	exp_inverse(v[197], v[196]);
+	extended_division(v[196], v[195], v[5], gap);
+	extended_division(v[196], v[5], v[195], gap);
+	mul(v[196], v[195], v[5]);
+	equality_constraint_inverse(v[194], -0.5);
+	substraction_inverse(v[194], v[193], v[22]);
+	substraction_inverse(v[193], v[192], v[191]);
+	extended_division(v[192], v[13], v[190], gap);
+	extended_division(v[192], v[190], v[13], gap);
+	mul(v[192], v[13], v[190]);
+	extended_division(v[191], v[184], v[4], gap);
+	extended_division(v[191], v[4], v[184], gap);
+	mul(v[191], v[184], v[4]);
+	division_inverse(v[190], v[189], v[188], gap);
+	addition_inverse(v[188], v[186], v[187]);
+	division_inverse(v[186], v[185], v[5], gap);
+	substraction_inverse(v[184], v[183], v[15]);
+	addition_inverse(v[183], v[13], v[182]);
+	equality_constraint_inverse(v[181], 0.0);
+	substraction_inverse(v[181], v[180], v[65]);
+	substraction_inverse(v[180], v[179], v[178]);
+	extended_division(v[179], v[10], v[172], gap);
+	extended_division(v[179], v[172], v[10], gap);
+	mul(v[179], v[10], v[172]);
+	extended_division(v[178], v[151], v[177], gap);
+	extended_division(v[178], v[177], v[151], gap);
+	mul(v[178], v[151], v[177]);
+	extended_division(v[177], v[176], v[175], gap);
+	extended_division(v[177], v[175], v[176], gap);
+	mul(v[177], v[176], v[175]);
+	exp_inverse(v[175], v[174]);
+	extended_division(v[174], v[173], v[1], gap);
+	extended_division(v[174], v[1], v[173], gap);
+	mul(v[174], v[173], v[1]);
+	addition_inverse(v[172], v[171], v[166]);
+	extended_division(v[171], v[170], v[169], gap);
+	extended_division(v[171], v[169], v[170], gap);
+	mul(v[171], v[170], v[169]);
+	exp_inverse(v[169], v[168]);
+	extended_division(v[168], v[167], v[2], gap);
+	extended_division(v[168], v[2], v[167], gap);
+	mul(v[168], v[167], v[2]);
+	extended_division(v[166], v[165], v[164], gap);
+	extended_division(v[166], v[164], v[165], gap);
+	mul(v[166], v[165], v[164]);
+	exp_inverse(v[164], v[163]);
+	extended_division(v[163], v[162], v[2], gap);
+	extended_division(v[163], v[2], v[162], gap);
+	mul(v[163], v[162], v[2]);
+	equality_constraint_inverse(v[161], 0.0);
+	substraction_inverse(v[161], v[160], v[22]);
+	substraction_inverse(v[160], v[159], v[158]);
+	extended_division(v[159], v[10], v[157], gap);
+	extended_division(v[159], v[157], v[10], gap);
+	mul(v[159], v[10], v[157]);
+	extended_division(v[158], v[151], v[1], gap);
+	extended_division(v[158], v[1], v[151], gap);
+	mul(v[158], v[151], v[1]);
+	division_inverse(v[157], v[156], v[155], gap);
+	addition_inverse(v[155], v[153], v[154]);
+	division_inverse(v[153], v[152], v[2], gap);
+	substraction_inverse(v[151], v[10], v[15]);
+	equality_constraint_inverse(v[150], -0.096804699999999994);
+	substraction_inverse(v[150], v[149], v[65]);
+	substraction_inverse(v[149], v[148], v[147]);
+	extended_division(v[148], v[14], v[141], gap);
+	extended_division(v[148], v[141], v[14], gap);
+	mul(v[148], v[14], v[141]);
+	extended_division(v[147], v[120], v[146], gap);
+	extended_division(v[147], v[146], v[120], gap);
+	mul(v[147], v[120], v[146]);
+	extended_division(v[146], v[145], v[144], gap);
+	extended_division(v[146], v[144], v[145], gap);
+	mul(v[146], v[145], v[144]);
+	exp_inverse(v[144], v[143]);
+	extended_division(v[143], v[142], v[5], gap);
+	extended_division(v[143], v[5], v[142], gap);
+	mul(v[143], v[142], v[5]);
+	addition_inverse(v[141], v[140], v[135]);
+	extended_division(v[140], v[139], v[138], gap);
+	extended_division(v[140], v[138], v[139], gap);
+	mul(v[140], v[139], v[138]);
+	exp_inverse(v[138], v[137]);
+	extended_division(v[137], v[136], v[6], gap);
+	extended_division(v[137], v[6], v[136], gap);
+	mul(v[137], v[136], v[6]);
+	extended_division(v[135], v[134], v[133], gap);
+	extended_division(v[135], v[133], v[134], gap);
+	mul(v[135], v[134], v[133]);
+	exp_inverse(v[133], v[132]);
+	extended_division(v[132], v[131], v[6], gap);
+	extended_division(v[132], v[6], v[131], gap);
+	mul(v[132], v[131], v[6]);
+	equality_constraint_inverse(v[130], -0.5);
+	substraction_inverse(v[130], v[129], v[22]);
+	substraction_inverse(v[129], v[128], v[127]);
+	extended_division(v[128], v[14], v[126], gap);
+	extended_division(v[128], v[126], v[14], gap);
+	mul(v[128], v[14], v[126]);
+	extended_division(v[127], v[120], v[5], gap);
+	extended_division(v[127], v[5], v[120], gap);
+	mul(v[127], v[120], v[5]);
+	division_inverse(v[126], v[125], v[124], gap);
+	addition_inverse(v[124], v[122], v[123]);
+	division_inverse(v[122], v[121], v[6], gap);
+	substraction_inverse(v[120], v[119], v[15]);
+	addition_inverse(v[119], v[14], v[118]);
+	equality_constraint_inverse(v[117], 0.0);
+	substraction_inverse(v[117], v[116], v[65]);
+	substraction_inverse(v[116], v[115], v[114]);
+	extended_division(v[115], v[9], v[108], gap);
+	extended_division(v[115], v[108], v[9], gap);
+	mul(v[115], v[9], v[108]);
+	extended_division(v[114], v[87], v[113], gap);
+	extended_division(v[114], v[113], v[87], gap);
+	mul(v[114], v[87], v[113]);
+	extended_division(v[113], v[112], v[111], gap);
+	extended_division(v[113], v[111], v[112], gap);
+	mul(v[113], v[112], v[111]);
+	exp_inverse(v[111], v[110]);
+	extended_division(v[110], v[109], v[0], gap);
+	extended_division(v[110], v[0], v[109], gap);
+	mul(v[110], v[109], v[0]);
+	addition_inverse(v[108], v[107], v[102]);
+	extended_division(v[107], v[106], v[105], gap);
+	extended_division(v[107], v[105], v[106], gap);
+	mul(v[107], v[106], v[105]);
+	exp_inverse(v[105], v[104]);
+	extended_division(v[104], v[103], v[1], gap);
+	extended_division(v[104], v[1], v[103], gap);
+	mul(v[104], v[103], v[1]);
+	extended_division(v[102], v[101], v[100], gap);
+	extended_division(v[102], v[100], v[101], gap);
+	mul(v[102], v[101], v[100]);
+	exp_inverse(v[100], v[99]);
+	extended_division(v[99], v[98], v[1], gap);
+	extended_division(v[99], v[1], v[98], gap);
+	mul(v[99], v[98], v[1]);
+	equality_constraint_inverse(v[97], 0.0);
+	substraction_inverse(v[97], v[96], v[22]);
+	substraction_inverse(v[96], v[95], v[94]);
+	extended_division(v[95], v[9], v[93], gap);
+	extended_division(v[95], v[93], v[9], gap);
+	mul(v[95], v[9], v[93]);
+	extended_division(v[94], v[87], v[0], gap);
+	extended_division(v[94], v[0], v[87], gap);
+	mul(v[94], v[87], v[0]);
+	division_inverse(v[93], v[92], v[91], gap);
+	addition_inverse(v[91], v[89], v[90]);
+	division_inverse(v[89], v[88], v[1], gap);
+	substraction_inverse(v[87], v[9], v[15]);
+	equality_constraint_inverse(v[86], -0.096804699999999994);
+	substraction_inverse(v[86], v[85], v[65]);
+	substraction_inverse(v[85], v[84], v[82]);
+	extended_division(v[84], v[83], v[76], gap);
+	extended_division(v[84], v[76], v[83], gap);
+	mul(v[84], v[83], v[76]);
+	extended_division(v[82], v[34], v[81], gap);
+	extended_division(v[82], v[81], v[34], gap);
+	mul(v[82], v[34], v[81]);
+	extended_division(v[81], v[80], v[79], gap);
+	extended_division(v[81], v[79], v[80], gap);
+	mul(v[81], v[80], v[79]);
+	exp_inverse(v[79], v[78]);
+	extended_division(v[78], v[77], v[6], gap);
+	extended_division(v[78], v[6], v[77], gap);
+	mul(v[78], v[77], v[6]);
+	addition_inverse(v[76], v[75], v[70]);
+	extended_division(v[75], v[74], v[73], gap);
+	extended_division(v[75], v[73], v[74], gap);
+	mul(v[75], v[74], v[73]);
+	exp_inverse(v[73], v[72]);
+	extended_division(v[72], v[71], v[7], gap);
+	extended_division(v[72], v[7], v[71], gap);
+	mul(v[72], v[71], v[7]);
+	extended_division(v[70], v[69], v[68], gap);
+	extended_division(v[70], v[68], v[69], gap);
+	mul(v[70], v[69], v[68]);
+	exp_inverse(v[68], v[67]);
+	extended_division(v[67], v[66], v[7], gap);
+	extended_division(v[67], v[7], v[66], gap);
+	mul(v[67], v[66], v[7]);
+	addition_inverse(v[65], v[64], v[62]);
+	extended_division(v[64], v[8], v[63], gap);
+	extended_division(v[64], v[63], v[8], gap);
+	mul(v[64], v[8], v[63]);
+	substraction_inverse(v[63], v[56], v[61]);
+	extended_division(v[62], v[15], v[61], gap);
+	extended_division(v[62], v[61], v[15], gap);
+	mul(v[62], v[15], v[61]);
+	extended_division(v[61], v[60], v[59], gap);
+	extended_division(v[61], v[59], v[60], gap);
+	mul(v[61], v[60], v[59]);
+	exp_inverse(v[59], v[58]);
+	extended_division(v[58], v[57], v[21], gap);
+	extended_division(v[58], v[21], v[57], gap);
+	mul(v[58], v[57], v[21]);
+	addition_inverse(v[56], v[55], v[50]);
+	extended_division(v[55], v[54], v[53], gap);
+	extended_division(v[55], v[53], v[54], gap);
+	mul(v[55], v[54], v[53]);
+	exp_inverse(v[53], v[52]);
+	extended_division(v[52], v[51], v[0], gap);
+	extended_division(v[52], v[0], v[51], gap);
+	mul(v[52], v[51], v[0]);
+	extended_division(v[50], v[49], v[48], gap);
+	extended_division(v[50], v[48], v[49], gap);
+	mul(v[50], v[49], v[48]);
+	exp_inverse(v[48], v[47]);
+	extended_division(v[47], v[46], v[0], gap);
+	extended_division(v[47], v[0], v[46], gap);
+	mul(v[47], v[46], v[0]);
+	equality_constraint_inverse(v[45], -0.5);
+	substraction_inverse(v[45], v[44], v[22]);
+	substraction_inverse(v[44], v[43], v[41]);
+	extended_division(v[43], v[42], v[40], gap);
+	extended_division(v[43], v[40], v[42], gap);
+	mul(v[43], v[42], v[40]);
+	extended_division(v[41], v[34], v[6], gap);
+	extended_division(v[41], v[6], v[34], gap);
+	mul(v[41], v[34], v[6]);
+	division_inverse(v[40], v[39], v[38], gap);
+	addition_inverse(v[38], v[36], v[37]);
+	division_inverse(v[36], v[35], v[7], gap);
+	substraction_inverse(v[34], v[33], v[15]);
+	equality_constraint_inverse(v[32], 0.5);
+	addition_inverse(v[32], v[31], v[22]);
+	extended_division(v[31], v[30], v[7], gap);
+	extended_division(v[31], v[7], v[30], gap);
+	mul(v[31], v[30], v[7]);
+	substraction_inverse(v[30], v[29], v[15]);
+	equality_constraint_inverse(v[28], 0.95999999999999996);
+	extended_division(v[28], v[27], v[26], gap);
+	extended_division(v[28], v[26], v[27], gap);
+	mul(v[28], v[27], v[26]);
+	substraction_inverse(v[27], v[8], v[15]);
+	substraction_inverse(v[26], v[25], v[24]);
+	extended_division(v[24], v[23], v[21], gap);
+	extended_division(v[24], v[21], v[23], gap);
+	mul(v[24], v[23], v[21]);
+	extended_division(v[22], v[15], v[21], gap);
+	extended_division(v[22], v[21], v[15], gap);
+	mul(v[22], v[15], v[21]);
+	division_inverse(v[21], v[20], v[19], gap);
+	addition_inverse(v[19], v[17], v[18]);
+	division_inverse(v[17], v[16], v[0], gap);
+}
+
+}
+
+}
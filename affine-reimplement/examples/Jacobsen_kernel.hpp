@@ -0,0 +1,29 @@
+// Generated by asol::code_generator from Jacobsen, do not edit
+
+#ifndef JACOBSEN_KERNEL_HPP_
+#define JACOBSEN_KERNEL_HPP_
+
+namespace asol {
+
+class interval;
+
+namespace Jacobsen_kernel {
+
+const int NUMBER_OF_VARIABLES = 16;
+
+const int NUMBER_OF_NODES = 277;
+
+// v must have NUMBER_OF_NODES elements, box NUMBER_OF_VARIABLES
+void set_box(interval* v, const interval* box);
+
+// For affine, v must be set up as in expression_graph<affine>
+template <typename T>
+void evaluate(T* v);
+
+void revise(interval* v);
+
+}
+
+}
+
+#endif // JACOBSEN_KERNEL_HPP_
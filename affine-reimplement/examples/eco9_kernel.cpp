@@ -0,0 +1,237 @@
+// Generated by asol::code_generator from eco9, do not edit
+
+#include "eco9_kernel.hpp"
+#include "evaluate.hpp"
+
+namespace asol {
+
+namespace eco9_kernel {
+
+void set_box(interval* v, const interval* box) {
+
+	for (int i=0; i<NUMBER_OF_VARIABLES; ++i) {
+
+		v[i] = box[i];
+	}
+
+	for (int i=NUMBER_OF_VARIABLES; i<NUMBER_OF_NODES; ++i) {
+
+		v[i] = interval::ANY_REAL();
+	}
+
+	v[8] = interval(0.875);
+	v[12] = interval(0.75);
+	v[18] = interval(0.625);
+	v[33] = interval(0.5);
+	v[43] = interval(0.375);
+	v[49] = interval(1.0);
+	v[55] = interval(0.25);
+	v[67] = interval(0.125);
+}
+
+template <typename T>
+void evaluate(T* v) {
+
+	sub(v[9], v[8], v[0]);
+	mul(v[10], v[7], v[9]);
+	sub(v[11], v[6], v[10]);
+	v[11].equals(0.0);
+	sub(v[13], v[12], v[1]);
+	mul(v[14], v[7], v[13]);
+	mul(v[15], v[0], v[6]);
+	sub(v[16], v[15], v[14]);
+	add(v[17], v[5], v[16]);
+	v[17].equals(0.0);
+	sub(v[19], v[18], v[2]);
+	mul(v[20], v[7], v[19]);
+	mul(v[21], v[1], v[6]);
+	mul(v[22], v[0], v[5]);
+	add(v[23], v[22], v[21]);
+	sub(v[24], v[23], v[20]);
+	add(v[25], v[4], v[24]);
+	v[25].equals(0.0);
+	add(v[26], v[0], v[1]);
+	add(v[27], v[26], v[2]);
+	add(v[28], v[27], v[4]);
+	add(v[29], v[28], v[5]);
+	add(v[30], v[29], v[6]);
+	add(v[31], v[30], v[7]);
+	add(v[32], v[3], v[31]);
+	v[32].equals(-1.0);
+	sub(v[34], v[33], v[3]);
+	mul(v[35], v[7], v[34]);
+	mul(v[36], v[2], v[6]);
+	mul(v[37], v[1], v[5]);
+	mul(v[38], v[0], v[4]);
+	add(v[39], v[38], v[37]);
+	add(v[40], v[39], v[36]);
+	sub(v[41], v[40], v[35]);
+	add(v[42], v[3], v[41]);
+	v[42].equals(0.0);
+	sub(v[44], v[43], v[4]);
+	mul(v[45], v[7], v[44]);
+	mul(v[46], v[1], v[4]);
+	add(v[47], v[0], v[6]);
+	mul(v[48], v[3], v[47]);
+	add(v[50], v[5], v[49]);
+	mul(v[51], v[2], v[50]);
+	add(v[52], v[51], v[48]);
+	add(v[53], v[52], v[46]);
+	sub(v[54], v[53], v[45]);
+	v[54].equals(0.0);
+	sub(v[56], v[55], v[5]);
+	mul(v[57], v[7], v[56]);
+	mul(v[58], v[4], v[6]);
+	add(v[59], v[1], v[5]);
+	mul(v[60], v[3], v[59]);
+	add(v[61], v[0], v[4]);
+	mul(v[62], v[2], v[61]);
+	add(v[63], v[1], v[62]);
+	add(v[64], v[63], v[60]);
+	add(v[65], v[64], v[58]);
+	sub(v[66], v[65], v[57]);
+	v[66].equals(0.0);
+	sub(v[68], v[67], v[6]);
+	mul(v[69], v[7], v[68]);
+	add(v[70], v[4], v[6]);
+	mul(v[71], v[5], v[70]);
+	add(v[72], v[2], v[4]);
+	mul(v[73], v[3], v[72]);
+	add(v[74], v[0], v[2]);
+	mul(v[75], v[1], v[74]);
+	add(v[76], v[0], v[75]);
+	add(v[77], v[76], v[73]);
+	add(v[78], v[77], v[71]);
+	sub(v[79], v[78], v[69]);
+	v[79].equals(0.0);
+}
+
+template void evaluate<interval>(interval* v);
+
+template void evaluate<affine>(affine* v);
+
+void revise(interval* v) {
+
+	interval gap;
+
+	equality_constraint_inverse(v[79], 0.0);
+	substraction_inverse(v[79], v[78], v[69]);
+	addition_inverse(v[78], v[77], v[71]);
+	addition_inverse(v[77], v[76], v[73]);
+	addition_inverse(v[76], v[0], v[75]);
+	extended_division(v[75], v[1], v[74], gap);
+	extended_division(v[75], v[74], v[1], gap);
+	mul(v[75], v[1], v[74]);
+	addition_inverse(v[74], v[0], v[2]);
+	extended_division(v[73], v[3], v[72], gap);
+	extended_division(v[73], v[72], v[3], gap);
+	mul(v[73], v[3], v[72]);
+	addition_inverse(v[72], v[2], v[4]);
+	extended_division(v[71], v[5], v[70], gap);
+	extended_division(v[71], v[70], v[5], gap);
+	mul(v[71], v[5], v[70]);
+	addition_inverse(v[70], v[4], v[6]);
+	extended_division(v[69], v[7], v[68], gap);
+	extended_division(v[69], v[68], v[7], gap);
+	mul(v[69], v[7], v[68]);
+	substraction_inverse(v[68], v[67], v[6]);
+	equality_constraint_inverse(v[66], 0.0);
+	substraction_inverse(v[66], v[65], v[57]);
+	addition_inverse(v[65], v[64], v[58]);
+	addition_inverse(v[64], v[63], v[60]);
+	addition_inverse(v[63], v[1], v[62]);
+	extended_division(v[62], v[2], v[61], gap);
+	extended_division(v[62], v[61], v[2], gap);
+	mul(v[62], v[2], v[61]);
+	addition_inverse(v[61], v[0], v[4]);
+	extended_division(v[60], v[3], v[59], gap);
+	extended_division(v[60], v[59], v[3], gap);
+	mul(v[60], v[3], v[59]);
+	addition_inverse(v[59], v[1], v[5]);
+	extended_division(v[58], v[4], v[6], gap);
+	extended_division(v[58], v[6], v[4], gap);
+	mul(v[58], v[4], v[6]);
+	extended_division(v[57], v[7], v[56], gap);
+	extended_division(v[57], v[56], v[7], gap);
+	mul(v[57], v[7], v[56]);
+	substraction_inverse(v[56], v[55], v[5]);
+	equality_constraint_inverse(v[54], 0.0);
+	substraction_inverse(v[54], v[53], v[45]);
+	addition_inverse(v[53], v[52], v[46]);
+	addition_inverse(v[52], v[51], v[48]);
+	extended_division(v[51], v[2], v[50], gap);
+	extended_division(v[51], v[50], v[2], gap);
+	mul(v[51], v[2], v[50]);
+	addition_inverse(v[50], v[5], v[49]);
+	extended_division(v[48], v[3], v[47], gap);
+	extended_division(v[48], v[47], v[3], gap);
+	mul(v[48], v[3], v[47]);
+	addition_inverse(v[47], v[0], v[6]);
+	extended_division(v[46], v[1], v[4], gap);
+	extended_division(v[46], v[4], v[1], gap);
+	mul(v[46], v[1], v[4]);
+	extended_division(v[45], v[7], v[44], gap);
+	extended_division(v[45], v[44], v[7], gap);
+	mul(v[45], v[7], v[44]);
+	substraction_inverse(v[44], v[43], v[4]);
+	equality_constraint_inverse(v[42], 0.0);
+	addition_inverse(v[42], v[3], v[41]);
+	substraction_inverse(v[41], v[40], v[35]);
+	addition_inverse(v[40], v[39], v[36]);
+	addition_inverse(v[39], v[38], v[37]);
+	extended_division(v[38], v[0], v[4], gap);
+	extended_division(v[38], v[4], v[0], gap);
+	mul(v[38], v[0], v[4]);
+	extended_division(v[37], v[1], v[5], gap);
+	extended_division(v[37], v[5], v[1], gap);
+	mul(v[37], v[1], v[5]);
+	extended_division(v[36], v[2], v[6], gap);
+	extended_division(v[36], v[6], v[2], gap);
+	mul(v[36], v[2], v[6]);
+	extended_division(v[35], v[7], v[34], gap);
+	extended_division(v[35], v[34], v[7], gap);
+	mul(v[35], v[7], v[34]);
+	substraction_inverse(v[34], v[33], v[3]);
+	equality_constraint_inverse(v[32], -1.0);
+	addition_inverse(v[32], v[3], v[31]);
+	addition_inverse(v[31], v[30], v[7]);
+	addition_inverse(v[30], v[29], v[6]);
+	addition_inverse(v[29], v[28], v[5]);
+	addition_inverse(v[28], v[27], v[4]);
+	addition_inverse(v[27], v[26], v[2]);
+	addition_inverse(v[26], v[0], v[1]);
+	equality_constraint_inverse(v[25], 0.0);
+	addition_inverse(v[25], v[4], v[24]);
+	substraction_inverse(v[24], v[23], v[20]);
+	addition_inverse(v[23], v[22], v[21]);
+	extended_division(v[22], v[0], v[5], gap);
+	extended_division(v[22], v[5], v[0], gap);
+	mul(v[22], v[0], v[5]);
+	extended_division(v[21], v[1], v[6], gap);
+	extended_division(v[21], v[6], v[1], gap);
+	mul(v[21], v[1], v[6]);
+	extended_division(v[20], v[7], v[19], gap);
+	extended_division(v[20], v[19], v[7], gap);
+	mul(v[20], v[7], v[19]);
+	substraction_inverse(v[19], v[18], v[2]);
+	equality_constraint_inverse(v[17], 0.0);
+	addition_inverse(v[17], v[5], v[16]);
+	substraction_inverse(v[16], v[15], v[14]);
+	extended_division(v[15], v[0], v[6], gap);
+	extended_division(v[15], v[6], v[0], gap);
+	mul(v[15], v[0], v[6]);
+	extended_division(v[14], v[7], v[13], gap);
+	extended_division(v[14], v[13], v[7], gap);
+	mul(v[14], v[7], v[13]);
+	substraction_inverse(v[13], v[12], v[1]);
+	equality_constraint_inverse(v[11], 0.0);
+	substraction_inverse(v[11], v[6], v[10]);
+	extended_division(v[10], v[7], v[9], gap);
+	extended_division(v[10], v[9], v[7], gap);
+	mul(v[10], v[7], v[9]);
+	substraction_inverse(v[9], v[8], v[0]);
+}
+
+}
+
+}
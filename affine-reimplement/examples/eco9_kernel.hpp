@@ -0,0 +1,29 @@
+// Generated by asol::code_generator from eco9, do not edit
+
+#ifndef ECO9_KERNEL_HPP_
+#define ECO9_KERNEL_HPP_
+
+namespace asol {
+
+class interval;
+
+namespace eco9_kernel {
+
+const int NUMBER_OF_VARIABLES = 8;
+
+const int NUMBER_OF_NODES = 80;
+
+// v must have NUMBER_OF_NODES elements, box NUMBER_OF_VARIABLES
+void set_box(interval* v, const interval* box);
+
+// For affine, v must be set up as in expression_graph<affine>
+template <typename T>
+void evaluate(T* v);
+
+void revise(interval* v);
+
+}
+
+}
+
+#endif // ECO9_KERNEL_HPP_
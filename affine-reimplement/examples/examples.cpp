@@ -20,7 +20,10 @@
 //
 //==============================================================================
 
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <sys/time.h>
 #include "Challenge.hpp"
 #include "Example_1.hpp"
 #include "Example_2.hpp"
@@ -32,8 +35,16 @@
 #include "Wilson16.hpp"
 #include "expression_graph_test.hpp"
 #include "builder.hpp"
+#include "code_generator.hpp"
+#include "Jacobsen_kernel.hpp"
+#include "eco9_kernel.hpp"
 #include "interval.hpp"
 #include "search_procedure.hpp"
+#include "parallel_search.hpp"
+#include "lp_solver.hpp"
+#include "lp_trace.hpp"
+#include "threads.hpp"
+#include "diagnostics.hpp"
 #include "affine_expr_graph_test.hpp"
 
 using namespace std;
@@ -204,6 +215,46 @@ void eco9_gap_probing() {
 	gap_probing_test(new eco9<builder> (), x, sol, 8);
 }
 
+void Jacobsen_revision_strategies() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen solutions, prefix sweep vs. worklist" << endl;
+
+	compare_revision_strategies(new Jacobsen<builder> ());
+}
+
+void Jacobsen_batch_revision() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen batch revision" << endl;
+
+	compare_batch_with_scalar(new Jacobsen<builder> ());
+}
+
+void Jacobsen_interval_newton() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen interval Newton" << endl;
+
+	test_interval_newton(new Jacobsen<builder> ());
+}
+
+void Bratu_interval_newton() {
+
+	cout << "###############################################" << endl;
+	cout << "Bratu interval Newton" << endl;
+
+	test_interval_newton(new Bratu<builder> ());
+}
+
+void eco9_batch_revision() {
+
+	cout << "###############################################" << endl;
+	cout << "eco9 batch revision" << endl;
+
+	compare_batch_with_scalar(new eco9<builder> ());
+}
+
 void index_recorder_test() {
 
 	cout << "###############################################" << endl;
@@ -238,8 +289,18 @@ void run_examples() {
 
 	Jacobsen_solutions_probing();
 
+	Jacobsen_revision_strategies();
+
+	Jacobsen_batch_revision();
+
+	Jacobsen_interval_newton();
+
+	Bratu_interval_newton();
+
 	eco9_solutions_iterative_revise();
 
+	eco9_batch_revision();
+
 	Wilson16_solutions_probing();
 
 	eco9_extended_division_test();
@@ -249,6 +310,122 @@ void run_examples() {
 	builder::release();
 }
 
+const double NEWTON_TEST_RADIUS = 1.0e-3;
+
+const double NEWTON_TEST_TOL = 1.0e-6; // the proof comes long before that
+
+// Started from a box around a solution, interval Newton proves the solution
+// unique and ends the box before it converges; no split is needed
+void run_newton_proof_test() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen interval Newton ends the box" << endl;
+
+	const problem<builder>* const prob = new Jacobsen<builder> ();
+
+	const DoubleArray2D solutions(prob->solutions());
+
+	delete prob;
+
+	for (size_t i=0; i<solutions.size(); ++i) {
+
+		const std::vector<double>& sol = solutions.at(i);
+
+		std::vector<interval> box;
+
+		for (size_t j=0; j<sol.size(); ++j) {
+
+			box.push_back(interval(sol.at(j)-NEWTON_TEST_RADIUS, sol.at(j)+NEWTON_TEST_RADIUS));
+		}
+
+		search_procedure algorithm(new Jacobsen<builder> ());
+
+		algorithm.set_convergence_tolerance(NEWTON_TEST_TOL);
+
+		algorithm.set_initial_box(box);
+
+		algorithm.run();
+
+		const search_procedure::statistics stats = algorithm.get_statistics();
+
+		ASSERT2(stats.splits==0 && stats.solutions_found==1 && stats.solutions_proved==1,
+				"splits: "<<stats.splits<<", solutions: "<<stats.solutions_found<<", proved: "<<stats.solutions_proved);
+
+		ASSERT(algorithm.found_solution_counters().at(i) == 1);
+
+		cout << "Solution " << (i+1) << " of " << solutions.size() << " proved unique without splits" << endl;
+	}
+}
+
+// The children of each split box start from the enclosures of their parent;
+// the search must find the same known solutions as without, each once
+void run_node_inheritance_test() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen with node enclosure inheritance" << endl;
+
+	for (int inherit=0; inherit<=1; ++inherit) {
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		search_procedure algorithm(new Jacobsen<builder> (), LP_DUAL_SIMPLEX);
+
+		algorithm.set_node_inheritance(inherit==1);
+
+		algorithm.run();
+
+		cout.rdbuf(buffer);
+
+		cout.clear();
+
+		const std::vector<int>& found = algorithm.found_solution_counters();
+
+		ASSERT(!found.empty());
+
+		for (size_t i=0; i<found.size(); ++i) {
+
+			ASSERT2(found.at(i) == 1, "inheritance: "<<inherit<<", solution "<<i<<" found "<<found.at(i)<<" times");
+		}
+
+		const search_procedure::statistics stats = algorithm.get_statistics();
+
+		cout << "Inheritance " << (inherit ? "on" : "off") << ", splits: " << stats.splits;
+		cout << ", each of the " << found.size() << " known solutions found once" << endl;
+	}
+}
+
+void run_warm_start_test() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen, simplex iterations with and without warm start" << endl;
+
+	uint64_t iterations[2];
+
+	for (int warm=0; warm<=1; ++warm) {
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		search_procedure algorithm(new Jacobsen<builder> (), LP_DUAL_SIMPLEX);
+
+		algorithm.set_warm_start(warm==1);
+
+		algorithm.run();
+
+		cout.rdbuf(buffer);
+
+		cout.clear();
+
+		const search_procedure::statistics stats = algorithm.get_statistics();
+
+		iterations[warm] = stats.simplex_iterations;
+
+		cout << "Warm start " << (warm ? "on" : "off") << ", splits: " << stats.splits;
+		cout << ", simplex iterations: " << stats.simplex_iterations << endl;
+	}
+
+	ASSERT2(iterations[1] < iterations[0], "warm: "<<iterations[1]<<", cold: "<<iterations[0]);
+}
+
 void run_search_procedure() {
 
 	search_procedure algorithm(new Jacobsen<builder> ());
@@ -256,9 +433,344 @@ void run_search_procedure() {
 	algorithm.run();
 }
 
+void generate_kernels() {
+
+	generate_kernel(new Jacobsen<builder> (), "Jacobsen", "examples");
+
+	generate_kernel(new eco9<builder> (), "eco9", "examples");
+}
+
+void run_kernel_benchmark() {
+
+	cout << "###############################################" << endl;
+	cout << "Jacobsen generated kernel" << endl;
+
+	const generated_kernel Jacobsen_kernel = {
+			Jacobsen_kernel::NUMBER_OF_NODES,
+			Jacobsen_kernel::set_box,
+			Jacobsen_kernel::evaluate<interval>,
+			Jacobsen_kernel::revise
+	};
+
+	kernel_benchmark(new Jacobsen<builder> (), Jacobsen_kernel, 10000);
+
+	cout << "###############################################" << endl;
+	cout << "eco9 generated kernel" << endl;
+
+	const generated_kernel eco9_kernel = {
+			eco9_kernel::NUMBER_OF_NODES,
+			eco9_kernel::set_box,
+			eco9_kernel::evaluate<interval>,
+			eco9_kernel::revise
+	};
+
+	kernel_benchmark(new eco9<builder> (), eco9_kernel, 10000);
+
+	builder::release();
+}
+
+void run_parallel_search(int threads) {
+
+	parallel_search algorithm(new Jacobsen<builder> (), threads);
+
+	algorithm.run();
+}
+
+class search_task : public runnable {
+
+public:
+
+	explicit search_task(search_procedure* search) : search(search) { }
+
+	virtual void run() { search->run(); }
+
+private:
+
+	search_procedure* const search;
+};
+
+// Two independent solvers in one process, each with its own solver_context
+void run_concurrent_searches() {
+
+	search_procedure first(new Jacobsen<builder> ());
+
+	search_procedure second(new Jacobsen<builder> ());
+
+	search_task first_task(&first), second_task(&second);
+
+	std::vector<runnable*> tasks;
+
+	tasks.push_back(&first_task);
+
+	tasks.push_back(&second_task);
+
+	run_in_parallel(tasks);
+
+	const search_procedure::statistics a = first.get_statistics();
+
+	const search_procedure::statistics b = second.get_statistics();
+
+	ASSERT(a.splits==b.splits && a.solutions_found==b.solutions_found && a.boxes_processed==b.boxes_processed);
+
+	cout << "Concurrent searches agree, splits: " << a.splits << ", solutions: " << a.solutions_found << endl;
+}
+
+double wall_time() {
+
+	timeval t;
+
+	gettimeofday(&t, 0);
+
+	return t.tv_sec + t.tv_usec*1.0e-6;
+}
+
+// Only Jacobsen: search_procedure hard-codes its splitting strategy. The
+// dual simplex is used as the calls into PORT are serialized.
+void run_scaling_benchmark() {
+
+	const int max_threads = number_of_cores();
+
+	double serial_time = 0.0;
+
+	for (int n=1; n<=max_threads; n = (n<max_threads && 2*n>max_threads) ? max_threads : 2*n) {
+
+		parallel_search algorithm(new Jacobsen<builder> (), n, LP_DUAL_SIMPLEX);
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		const double start = wall_time();
+
+		algorithm.run();
+
+		const double elapsed = wall_time() - start;
+
+		cout.rdbuf(buffer);
+
+		cout.clear();
+
+		if (n==1) {
+			serial_time = elapsed;
+		}
+
+		const search_procedure::statistics& stats = algorithm.get_statistics();
+
+		cout << "threads: " << n << ", time: " << elapsed << " s, speedup: ";
+		cout << serial_time/elapsed << ", splits: " << stats.splits << ", solutions: ";
+		cout << stats.solutions_found << ", steals: " << algorithm.steals() << endl;
+	}
+}
+
+// The same search with each LP backend; all of them are linked, a backend
+// whose search throws is reported as failed and the next one is run
+void run_lp_backend_benchmark() {
+
+	const lp_backend backends[] = { LP_PORT, LP_GLPK, LP_DUAL_SIMPLEX };
+
+	const char* const names[] = { "PORT", "GLPK", "dual simplex" };
+
+	for (int i=0; i<3; ++i) {
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		try {
+
+			search_procedure algorithm(new Jacobsen<builder> (), backends[i]);
+
+			const double start = wall_time();
+
+			algorithm.run();
+
+			const double elapsed = wall_time() - start;
+
+			cout.rdbuf(buffer);
+
+			cout.clear();
+
+			const search_procedure::statistics& stats = algorithm.get_statistics();
+
+			cout << names[i] << ", time: " << elapsed << " s, splits: " << stats.splits;
+			cout << ", solutions: " << stats.solutions_found << endl;
+		}
+		catch (std::exception& e) {
+
+			cout.rdbuf(buffer);
+
+			cout.clear();
+
+			cout << names[i] << " failed: " << e.what() << endl;
+		}
+	}
+}
+
+// The same search with each LP scheduling policy, see contractor_scheduler
+void run_scheduling_benchmark() {
+
+	const lp_policy policies[] = { LP_ALWAYS, LP_ADAPTIVE, LP_NEVER };
+
+	const char* const names[] = { "always", "adaptive", "never" };
+
+	for (int i=0; i<3; ++i) {
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		search_procedure algorithm(new Jacobsen<builder> (), LP_DUAL_SIMPLEX);
+
+		scheduling_options options;
+
+		options.policy = policies[i];
+
+		algorithm.set_scheduling(options);
+
+		const double start = wall_time();
+
+		algorithm.run();
+
+		const double elapsed = wall_time() - start;
+
+		cout.rdbuf(buffer);
+
+		cout.clear();
+
+		const search_procedure::statistics& stats = algorithm.get_statistics();
+
+		cout << "LP " << names[i] << ", time: " << elapsed << " s, splits: " << stats.splits;
+		cout << ", solutions: " << stats.solutions_found << endl;
+	}
+}
+
+// The hybrid queue is given a budget of a few dozen boxes to make it dive,
+// the spilling queues keep a handful of boxes in memory
+void run_search_order_benchmark() {
+
+	const search_order orders[] = { BREADTH_FIRST, DEPTH_FIRST, BEST_FIRST, BEST_FIRST, HYBRID, BREADTH_FIRST, BREADTH_FIRST, DEPTH_FIRST };
+
+	const box_heuristic heuristics[] = { SMALLEST_MAX_WIDTH, SMALLEST_MAX_WIDTH, SMALLEST_MAX_WIDTH, SMALLEST_RESIDUAL, SMALLEST_MAX_WIDTH, SMALLEST_MAX_WIDTH, SMALLEST_MAX_WIDTH, SMALLEST_MAX_WIDTH };
+
+	const bool compact[] = { false, false, false, false, false, true, false, false };
+
+	const bool spill[] = { false, false, false, false, false, false, true, true };
+
+	const char* const names[] = { "breadth-first", "depth-first", "best-first (width)", "best-first (residual)", "hybrid (width)",
+	                              "breadth-first (split tree)", "breadth-first (spilled)", "depth-first (spilled)" };
+
+	for (int i=0; i<8; ++i) {
+
+		std::streambuf* const buffer = cout.rdbuf(0); // silence the search
+
+		search_procedure algorithm(new Jacobsen<builder> ());
+
+		search_options options;
+
+		options.order = orders[i];
+
+		options.heuristic = heuristics[i];
+
+		options.memory_budget = 16*1024;
+
+		options.compact_frontier = compact[i];
+
+		options.ram_budget = spill[i] ? 4*1024 : 0;
+
+		algorithm.set_search_order(options);
+
+		const double start = wall_time();
+
+		algorithm.run();
+
+		const double elapsed = wall_time() - start;
+
+		cout.rdbuf(buffer);
+
+		cout.clear();
+
+		const search_procedure::statistics& stats = algorithm.get_statistics();
+
+		cout << names[i] << ", time: " << elapsed << " s, splits: " << stats.splits;
+		cout << ", solutions: " << stats.solutions_found << ", peak frontier: " << stats.peak_frontier;
+		cout << ", splits to the first solution: " << stats.splits_to_first_solution << endl;
+	}
+}
+
+// Single pruning thread: the LPs solved on the clones are not recorded
+void run_lp_capture(const char* file) {
+
+	search_procedure algorithm(new Jacobsen<builder> (), LP_DUAL_SIMPLEX);
+
+	algorithm.capture_lp_trace(file);
+
+	algorithm.run();
+}
+
+// The captured LPs are solved again by each backend and compared to the
+// recorded outcomes and bounds
+void run_lp_replay(const char* file) {
+
+	const lp_trace_replay trace(file);
+
+	cout << "Records in the trace: " << trace.size() << endl;
+
+	const lp_backend backends[] = { LP_PORT, LP_GLPK, LP_DUAL_SIMPLEX };
+
+	const char* const names[] = { "PORT", "GLPK", "dual simplex" };
+
+	for (int i=0; i<3; ++i) {
+
+		try {
+
+			const std::auto_ptr<lp_impl> lp(lp_solver::new_lp_impl(backends[i]));
+
+			const lp_trace_replay::statistics stats = trace.run(lp.get());
+
+			cout << names[i] << ", solves: " << stats.solves << ", solves/sec: ";
+			cout << stats.solves/stats.seconds << ", outcome mismatches: " << stats.outcome_mismatches;
+			cout << ", bound discrepancies: " << stats.bound_discrepancies;
+			cout << " (max " << stats.max_discrepancy << ")" << endl;
+
+			lp->show_iteration_count();
+		}
+		catch (std::exception& e) {
+
+			cout << names[i] << " failed: " << e.what() << endl;
+		}
+	}
+}
+
+const double CHECKPOINT_PERIOD = 60.0; // seconds
+
+void run_checkpointed_search(const char* file) {
+
+	search_procedure algorithm(new Jacobsen<builder> ());
+
+	algorithm.set_checkpoint(file, CHECKPOINT_PERIOD);
+
+	algorithm.run();
+}
+
+// Continues where run_checkpointed_search() left off, and keeps writing
+// checkpoints to the same file
+void run_resumed_search(const char* file) {
+
+	search_procedure algorithm(new Jacobsen<builder> ());
+
+	algorithm.set_checkpoint(file, CHECKPOINT_PERIOD);
+
+	algorithm.resume(file);
+
+	algorithm.run();
+}
+
 void affine_expression_graph_test() {
 
 	affine_expr_graph_test(new Wilson16<builder> ());
 }
 
+void run_noise_term_limit_test() {
+
+	noise_term_limit_test(new Wilson16<builder> (), 2);
+
+	noise_term_limit_test(new Jacobsen<builder> (), 1);
+
+	noise_term_limit_test(new Jacobsen<builder> (), 4);
+}
+
 }
@@ -29,12 +29,44 @@ void run_search_procedure();
 
 void run_examples();
 
+void run_newton_proof_test();
+
+void run_node_inheritance_test();
+
+void run_warm_start_test();
+
 void show_Jacobsen_sparsity();
 
 void index_recorder_test();
 
 void affine_expression_graph_test();
 
+void run_noise_term_limit_test();
+
+void run_parallel_search(int threads);
+
+void run_scaling_benchmark();
+
+void run_concurrent_searches();
+
+void run_lp_backend_benchmark();
+
+void run_scheduling_benchmark();
+
+void run_search_order_benchmark();
+
+void run_lp_capture(const char* file);
+
+void run_lp_replay(const char* file);
+
+void run_checkpointed_search(const char* file);
+
+void run_resumed_search(const char* file);
+
+void generate_kernels();
+
+void run_kernel_benchmark();
+
 }
 
 #endif // EXAMPLES_HPP_
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <functional>
 #include <iostream> // FIXME Remove when ready
+#include <set>
 #include "expression_graph.hpp"
 #include "affine.hpp"
 #include "box_generator.hpp"
@@ -31,6 +32,7 @@
 #include "diagnostics.hpp"
 #include "exceptions.hpp"
 #include "gap_info.hpp"
+#include "incidence_recorder.hpp"
 #include "interval.hpp"
 #include "problem_data.hpp"
 #include "sol_tracker.hpp"
@@ -38,11 +40,19 @@
 
 using namespace std;
 
+namespace {
+
+const double REQUEUE_THRESHOLD = 0.01; // relative reduction of the diameter
+
+}
+
 namespace asol {
 
 template <typename T>
 extern const std::vector<primitive<T>*> convert(const std::vector<primitive<builder>*>& v);
 
+extern const std::vector<tape_record> convert_to_tape(const std::vector<primitive<builder>*>& v);
+
 template <typename T>
 expression_graph<T>::expression_graph(const problem_data* problem,
         const DoubleArray2D& solutions,
@@ -51,6 +61,7 @@ expression_graph<T>::expression_graph(const problem_data* problem,
 v          (problem->peek_index()),
 n_vars     (problem->number_of_variables()),
 primitives (convert<T>(problem->get_primitives())),
+tape       (convert_to_tape(problem->get_primitives())),
 constants  (problem->get_numeric_constants().begin(), problem->get_numeric_constants().end()),
 initial_box(problem->get_initial_box()),
 //index_sets (problem->get_index_sets()),
@@ -59,11 +70,17 @@ constraints(problem->get_constraints()),
 apriori_sols(solutions),
 tracker    (0),
 orig       (v.size()),
-hull       (v.size())
+hull       (v.size()),
+strategy   (CONSTRAINT_WORKLIST),
+requeue_threshold(REQUEUE_THRESHOLD),
+revision_counter(0),
+seeded     (false)
 
 {
 	set_variables();
 
+	init_incidence();
+
 	primitive<T>::set_vector(&v);
 }
 
@@ -121,6 +138,68 @@ void expression_graph<T>::set_box(const T* box, const int length) {
 
 	// TODO Could save this if intersect would not create empty an interval
 	set_numeric_consts();
+
+	revised_vars.clear();
+
+	seeded = false;
+}
+
+// The enclosures of the parent hold for every solution in the parent, so
+// they hold in its children too
+template <typename T>
+void expression_graph<T>::set_box(const T* box, const int length, const node_enclosures<T>& enclosures) {
+
+	set_box(box, length);
+
+	for (size_t i=0; i<enclosures.nodes.size(); ++i) {
+
+		const std::pair<int,T>& node = enclosures.nodes[i];
+
+		v.at(node.first) = node.second;
+	}
+
+	if (enclosures.vars.empty()) {
+
+		return;
+	}
+
+	ASSERT(static_cast<int>(enclosures.vars.size()) == n_vars);
+
+	std::set<int> changed;
+
+	for (int i=0; i<n_vars; ++i) {
+
+		if (box[i].inf() != enclosures.vars[i].inf() || box[i].sup() != enclosures.vars[i].sup()) {
+
+			const IntVector& neighbors = node_constraints.at(i);
+
+			changed.insert(neighbors.begin(), neighbors.end());
+		}
+	}
+
+	seeds.assign(changed.begin(), changed.end());
+
+	seeded = true;
+}
+
+template <typename T>
+void expression_graph<T>::save_enclosures(node_enclosures<T>& enclosures) const {
+
+	enclosures.vars = revised_vars;
+
+	enclosures.nodes.clear();
+
+	const int n = static_cast<int> (v.size());
+
+	const double unbounded = T::ANY_REAL().diameter();
+
+	for (int i=n_vars; i<n; ++i) {
+
+		if (v[i].diameter() < unbounded) {
+
+			enclosures.nodes.push_back(std::make_pair(i, v[i]));
+		}
+	}
 }
 
 template <typename T>
@@ -138,7 +217,7 @@ std::vector<T>* expression_graph<T>::get_v() { // TODO Find a better way to do t
 template <typename T>
 void expression_graph<T>::evaluate_all() {
 
-	for_each(primitives.begin(), primitives.end(), mem_fun(&primitive<T>::evaluate));
+	tape.evaluate(&v[0], 0, last_primitive());
 }
 
 template <typename T>
@@ -146,7 +225,7 @@ void expression_graph<T>::revise_all() {
 
 	evaluate_all();
 
-	for_each(primitives.rbegin(), primitives.rend(), mem_fun(&primitive<T>::revise));
+	tape.revise(&v[0], 0, last_primitive(), 0);
 }
 
 template <typename T>
@@ -168,27 +247,19 @@ void expression_graph<T>::evaluate_constraint(int k) {
 
 	const int end   = constraint_end(k);
 
-	for (int i=begin; i<=end; ++i) {
-
-		primitives.at(i)->evaluate();
-
-		//check_transitions_since_last_call();
-	}
+	tape.evaluate(&v[0], begin, end);
 }
 
 template <typename T>
 void expression_graph<T>::revise_constraint(int k) {
 
+	++revision_counter;
+
 	const int end   = constraint_end(k);
 
 	const int begin = constraint_begin(k);
 
-	for (int i=end; i>=begin; --i) {
-
-		primitives.at(i)->revise();
-
-		//check_transitions_since_last_call();
-	}
+	tape.revise(&v[0], begin, end, 0);
 }
 
 template <typename T>
@@ -226,6 +297,43 @@ void expression_graph<T>::revise_all2() {
 template <typename T>
 void expression_graph<T>::iterative_revision() {
 
+	if (strategy == PREFIX_SWEEP) {
+
+		prefix_sweep();
+	}
+	else {
+
+		worklist_revision();
+	}
+
+	revised_vars.assign(v.begin(), v.begin()+n_vars);
+
+	seeded = false;
+}
+
+template <typename T>
+void expression_graph<T>::set_revision_strategy(revision_strategy s) {
+
+	strategy = s;
+}
+
+template <typename T>
+void expression_graph<T>::set_requeue_threshold(double relative_reduction) {
+
+	ASSERT2(0 <= relative_reduction && relative_reduction < 1, "threshold: "<<relative_reduction);
+
+	requeue_threshold = relative_reduction;
+}
+
+template <typename T>
+int expression_graph<T>::constraint_revisions() const {
+
+	return revision_counter;
+}
+
+template <typename T>
+void expression_graph<T>::prefix_sweep() {
+
 	const int end = constraints_size();
 
 	for (int pos=0; pos<end; ++pos) {
@@ -235,17 +343,136 @@ void expression_graph<T>::iterative_revision() {
 }
 
 template <typename T>
-struct raii {
+void expression_graph<T>::init_incidence() {
+
+	incidence_recorder rec(static_cast<int> (v.size()));
+
+	const int m = constraints_size();
+
+	for (int k=0; k<m; ++k) {
+
+		const int end = constraint_end(k);
+
+		for (int i=constraint_begin(k); i<=end; ++i) {
+
+			primitives.at(i)->record(&rec);
+		}
+
+		rec.finish_constraint();
+	}
+
+	constraint_nodes = rec.constraint_nodes();
+
+	node_constraints = rec.node_constraints();
+
+	queued.assign(m, 'n');
+}
+
+// Each constraint is revised in isolation (HC4revise): the nodes shared with
+// other constraints always hold valid enclosures, so this is safe. A
+// constraint is put back into the worklist only if one of its nodes shrank
+// by more than the threshold when revising one of its neighbors.
+template <typename T>
+void expression_graph<T>::worklist_revision() {
+
+	const int m = constraints_size();
+
+	worklist.clear();
+
+	queued.assign(m, 'n');
+
+	if (seeded) {
+
+		for (size_t i=0; i<seeds.size(); ++i) {
+
+			enqueue(seeds[i]);
+		}
+	}
+	else {
+
+		for (int k=0; k<m; ++k) {
+
+			enqueue(k);
+		}
+	}
+
+	while (!worklist.empty()) {
+
+		const int k = worklist.front();
+
+		worklist.pop_front();
+
+		queued.at(k) = 'n';
+
+		save_snapshot(k);
+
+		evaluate_constraint(k);
+
+		revise_constraint(k);
+
+		requeue_neighbors(k);
+	}
+}
+
+template <typename T>
+void expression_graph<T>::enqueue(int k) {
+
+	if (queued.at(k)=='n') {
+
+		queued.at(k) = 'y';
+
+		worklist.push_back(k);
+	}
+}
+
+template <typename T>
+void expression_graph<T>::save_snapshot(int k) {
+
+	const IntVector& nodes = constraint_nodes.at(k);
+
+	snapshot.clear();
+
+	for (size_t i=0; i<nodes.size(); ++i) {
+
+		snapshot.push_back(v.at(nodes.at(i)));
+	}
+}
+
+template <typename T>
+void expression_graph<T>::requeue_neighbors(int k) {
+
+	const IntVector& nodes = constraint_nodes.at(k);
+
+	for (size_t i=0; i<nodes.size(); ++i) {
+
+		const int node = nodes.at(i);
+
+		if (!shrunk(snapshot.at(i), v.at(node))) {
 
-	raii(vector<gap_info<T> >* gaps) {
+			continue;
+		}
+
+		const IntVector& neighbors = node_constraints.at(node);
+
+		for (size_t j=0; j<neighbors.size(); ++j) {
 
-		gaps->clear();
+			const int c = neighbors.at(j);
 
-		primitive<T>::set_gap_container(gaps);
+			if (c != k) {
+
+				enqueue(c);
+			}
+		}
 	}
+}
+
+template <typename T>
+bool expression_graph<T>::shrunk(const T& before, const T& after) const {
 
-	~raii() { primitive<T>::set_gap_container(0); }
-};
+	const double width = before.diameter();
+
+	return (width > 0) && (width - after.diameter() > requeue_threshold*width);
+}
 
 template <typename T>
 void expression_graph<T>::iterative_revision_save_gaps() {
@@ -259,10 +486,9 @@ void expression_graph<T>::iterative_revision_save_gaps() {
 
 	evaluate_up_to(end-1);
 
-	raii<T> set_primitive_gap_container(&gaps);
-
-	for_each(primitives.rbegin(), primitives.rend(), mem_fun(&primitive<T>::revise));
+	gaps.clear();
 
+	tape.revise(&v[0], 0, last_primitive(), &gaps);
 }
 
 template <typename T>
@@ -570,10 +796,15 @@ const IntArray2D& constraint_index_sets) :
 v          (problem->peek_index()),
 n_vars     (problem->number_of_variables()),
 primitives (convert<T>(problem->get_primitives())),
+tape       (convert_to_tape(problem->get_primitives())),
 constants  (problem->get_numeric_constants().begin(), problem->get_numeric_constants().end()),
 index_sets (constraint_index_sets),
 constraints(problem->get_constraints()),
-tracker    (0)
+tracker    (0),
+strategy   (PREFIX_SWEEP),
+requeue_threshold(REQUEUE_THRESHOLD),
+revision_counter(0),
+seeded     (false)
 
 {
 	const int n = static_cast<int> (v.size());
@@ -597,12 +828,16 @@ tracker    (0)
 		v.at(p.first).make_numeric_constant();
 	}
 
+	T::keep_noise_terms(); // of the variables and the constants
+
 	primitive<T>::set_vector(&v);
 }
 
 template <typename T>
 void expression_graph<T>::reset_vars() {
 
+	T::release_noise_terms();
+
 	T::reset_counter();
 
 	for (int i=0; i<n_vars; ++i) {
@@ -631,9 +866,15 @@ template<> void expression_graph<affine>::set_non_variables();
 template<> void expression_graph<affine>::set_constant(const Pair p);
 template<> void expression_graph<affine>::set_numeric_consts();
 template<> void expression_graph<affine>::set_box(const affine* , const int );
+template<> void expression_graph<affine>::set_box(const affine* , const int , const node_enclosures<affine>& );
+template<> void expression_graph<affine>::save_enclosures(node_enclosures<affine>& ) const;
 template<> void expression_graph<affine>::revise_all();
 template<> void expression_graph<affine>::revise_all2();
 template<> void expression_graph<affine>::iterative_revision();
+template<> void expression_graph<affine>::prefix_sweep();
+template<> void expression_graph<affine>::worklist_revision();
+template<> void expression_graph<affine>::requeue_neighbors(int );
+template<> bool expression_graph<affine>::shrunk(const affine& , const affine& ) const;
 template<> void expression_graph<affine>::iterative_revision_save_gaps();
 template<> void expression_graph<affine>::probing();
 template<> void expression_graph<affine>::probing2();
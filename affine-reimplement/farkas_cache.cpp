@@ -0,0 +1,154 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include "farkas_cache.hpp"
+#include "diagnostics.hpp"
+#include "rounding_mode.hpp"
+#include "sparse_rows.hpp"
+
+using std::vector;
+
+namespace asol {
+
+farkas_cache::farkas_cache(int capacity) : capacity(capacity), hit_count(0) {
+
+	ASSERT2(capacity > 0, "capacity: "<<capacity);
+}
+
+void farkas_cache::add(const vector<double>& y, const sparse_rows& rows, int n_cols) {
+
+	certificate c;
+
+	for (int k=0; k<static_cast<int>(y.size()); ++k) {
+
+		if (y.at(k) != 0.0) {
+
+			c.push_back(std::make_pair(k, y.at(k)));
+		}
+	}
+
+	if (c.empty() || !proves(c, rows, n_cols)) {
+
+		return;
+	}
+
+	certificates.push_front(c);
+
+	if (static_cast<int>(certificates.size()) > capacity) {
+
+		certificates.pop_back();
+	}
+}
+
+bool farkas_cache::proves_infeasible(const sparse_rows& rows, int n_cols) {
+
+	for (std::deque<certificate>::iterator i=certificates.begin(); i!=certificates.end(); ++i) {
+
+		if (proves(*i, rows, n_cols)) {
+
+			std::rotate(certificates.begin(), i, i+1);
+
+			++hit_count;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Any solution satisfies sum_k y_k*(a_k^T x) = sum_k y_k*r_k. With x in
+// [-1, 1] the left hand side is within [-G, G] for G = sum_j |(A^T y)_j|;
+// the rows are infeasible if y^T r is outside of it for all r in the
+// row bounds.
+bool farkas_cache::proves(const certificate& y, const sparse_rows& rows, int n_cols) {
+
+	const int m = rows.size();
+
+	const int size = static_cast<int>(y.size());
+
+	if (y.at(size-1).first >= m) {
+
+		return false;
+	}
+
+	vector<double> g_lo(n_cols+1, 0.0), g_up(n_cols+1, 0.0);
+
+	rounding_mode mode(rounding_mode::DOWNWARD);
+
+	for (int i=0; i<size; ++i) {
+
+		const int k = y.at(i).first;
+
+		for (int p=rows.start.at(k); p<rows.start.at(k+1); ++p) {
+
+			g_lo.at(rows.index.at(p)) += rows.coeff.at(p)*y.at(i).second;
+		}
+	}
+
+	double yr_lo = 0.0;
+
+	for (int i=0; i<size; ++i) {
+
+		const int k = y.at(i).first;
+
+		const double y_k = y.at(i).second;
+
+		yr_lo += y_k*((y_k >= 0.0) ? rows.lb.at(k) : rows.ub.at(k));
+	}
+
+	mode.set(rounding_mode::UPWARD);
+
+	for (int i=0; i<size; ++i) {
+
+		const int k = y.at(i).first;
+
+		for (int p=rows.start.at(k); p<rows.start.at(k+1); ++p) {
+
+			g_up.at(rows.index.at(p)) += rows.coeff.at(p)*y.at(i).second;
+		}
+	}
+
+	double yr_up = 0.0;
+
+	for (int i=0; i<size; ++i) {
+
+		const int k = y.at(i).first;
+
+		const double y_k = y.at(i).second;
+
+		yr_up += y_k*((y_k >= 0.0) ? rows.ub.at(k) : rows.lb.at(k));
+	}
+
+	double G = 0.0;
+
+	for (int j=1; j<=n_cols; ++j) {
+
+		G += std::max(std::fabs(g_lo.at(j)), std::fabs(g_up.at(j)));
+	}
+
+	return (yr_lo > G) || (yr_up < -G);
+}
+
+}
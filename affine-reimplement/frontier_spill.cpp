@@ -0,0 +1,334 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "frontier_spill.hpp"
+#include "box_pool.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+#include "vector_dump.hpp"
+
+namespace {
+
+const int MAX_SEGMENT_BOXES = 1024;
+
+const int MIN_SEGMENTS_IN_MEMORY = 4;
+
+const char SPILL_FILE_TEMPLATE[] = "/asol_spill_XXXXXX";
+
+// The name is overwritten with the name of the created file
+int open_temporary(std::string& name) {
+
+	const char* const dir = std::getenv("TMPDIR");
+
+	name = (dir && *dir) ? dir : "/tmp";
+
+	name += SPILL_FILE_TEMPLATE;
+
+	std::vector<char> path(name.begin(), name.end());
+
+	path.push_back('\0');
+
+	const int fd = mkstemp(&path.at(0));
+
+	name = &path.at(0);
+
+	if (fd >= 0) {
+
+		unlink(name.c_str());
+	}
+
+	return fd;
+}
+
+}
+
+namespace asol {
+
+spill_file::spill_file(const char* file_name, std::size_t bytes_per_segment)
+: name(file_name ? file_name : ""),
+  temporary(file_name == 0),
+  segment_bytes(bytes_per_segment),
+  fd(temporary ? open_temporary(name) : open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600)),
+  base(0),
+  capacity(0),
+  used(0)
+{
+	ASSERT2(fd >= 0, "failed to open the spill file: "<<name);
+}
+
+void spill_file::grow() {
+
+	const int new_capacity = std::max(4, 2*capacity);
+
+	if (base) {
+
+		munmap(base, size());
+	}
+
+	const int failed = ftruncate(fd, new_capacity*segment_bytes);
+
+	ASSERT2(!failed, "failed to grow the spill file to segments: "<<new_capacity);
+
+	void* address = mmap(0, new_capacity*segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	ASSERT2(address != MAP_FAILED, "failed to map the spill file: "<<name);
+
+	base = static_cast<char*>(address);
+
+	capacity = new_capacity;
+}
+
+int spill_file::new_segment() {
+
+	if (!free_slots.empty()) {
+
+		const int slot = free_slots.back();
+
+		free_slots.pop_back();
+
+		return slot;
+	}
+
+	if (used == capacity) {
+
+		grow();
+	}
+
+	return used++;
+}
+
+double* spill_file::segment(int slot) const {
+
+	ASSERT2(0<=slot && slot<used, "slot, used: "<<slot<<", "<<used);
+
+	return reinterpret_cast<double*>(base + slot*segment_bytes);
+}
+
+void spill_file::release_segment(int slot) {
+
+	free_slots.push_back(slot);
+}
+
+spill_file::~spill_file() {
+
+	if (base) {
+
+		munmap(base, size());
+	}
+
+	close(fd);
+
+	if (!temporary) {
+
+		unlink(name.c_str());
+	}
+}
+
+namespace {
+
+int boxes_in_memory(const search_options& options, int n_vars) {
+
+	const std::size_t max_boxes = options.ram_budget/(n_vars*sizeof(interval));
+
+	return std::max(static_cast<int>(max_boxes), MIN_SEGMENTS_IN_MEMORY);
+}
+
+}
+
+spilling_queue::spilling_queue(const search_options& options,
+                               int number_of_variables,
+                               box_pool* box_source,
+                               spill_observer* spill_handler)
+: lifo(options.order == DEPTH_FIRST),
+  n_vars(number_of_variables),
+  record_size(2*n_vars+1),
+  max_boxes(boxes_in_memory(options, n_vars)),
+  segment_boxes(std::min(MAX_SEGMENT_BOXES, max_boxes/MIN_SEGMENTS_IN_MEMORY)),
+  pool(box_source),
+  observer(spill_handler),
+  file(options.spill_file, segment_boxes*record_size*sizeof(double)),
+  spilled_boxes(0),
+  spills(0)
+{
+	ASSERT2(options.order == BREADTH_FIRST || options.order == DEPTH_FIRST, "order: "<<options.order);
+}
+
+int spilling_queue::in_memory() const {
+
+	return static_cast<int>(oldest.size() + newest.size());
+}
+
+int spilling_queue::size() const {
+
+	return in_memory() + spilled_boxes;
+}
+
+void spilling_queue::push(interval* box, double ) {
+
+	newest.push_back(box);
+
+	update_peak();
+
+	if (in_memory() > max_boxes) {
+
+		spill();
+	}
+}
+
+// The front of newest is older than the rest of the memory in both orders,
+// and newer than the segments. If newest is empty, the back of oldest is
+// still older than the segments.
+void spilling_queue::spill() {
+
+	if (!newest.empty()) {
+
+		segments.push_back(write(newest, true));
+	}
+	else {
+
+		segments.push_front(write(oldest, false));
+	}
+
+	++spills;
+}
+
+spilling_queue::segment spilling_queue::write(std::deque<interval*>& boxes, bool from_front) {
+
+	const int n = std::min(segment_boxes, static_cast<int>(boxes.size()));
+
+	const int slot = file.new_segment();
+
+	double* record = file.segment(slot);
+
+	const std::deque<interval*>::iterator first = from_front ? boxes.begin() : boxes.end()-n;
+
+	for (std::deque<interval*>::iterator i=first; i!=first+n; ++i, record+=record_size) {
+
+		pack(*i, n_vars, record);
+
+		record[2*n_vars] = observer->box_spilled(*i);
+
+		pool->release(*i);
+	}
+
+	boxes.erase(first, first+n);
+
+	spilled_boxes += n;
+
+	return segment(slot, n);
+}
+
+void spilling_queue::restore(const segment& s, std::deque<interval*>& boxes) {
+
+	const double* record = file.segment(s.slot);
+
+	for (int i=0; i<s.count; ++i, record+=record_size) {
+
+		interval* box = pool->allocate();
+
+		unpack(record, n_vars, box);
+
+		observer->box_restored(box, static_cast<int>(record[2*n_vars]));
+
+		boxes.push_back(box);
+	}
+
+	file.release_segment(s.slot);
+
+	spilled_boxes -= s.count;
+}
+
+interval* spilling_queue::pop() {
+
+	ASSERT(size() > 0);
+
+	interval* box = 0;
+
+	if (lifo) {
+
+		if (newest.empty()) {
+
+			restore(segments.back(), newest);
+
+			segments.pop_back();
+		}
+
+		box = newest.back();
+
+		newest.pop_back();
+	}
+	else {
+
+		if (oldest.empty() && !segments.empty()) {
+
+			restore(segments.front(), oldest);
+
+			segments.pop_front();
+		}
+		else if (oldest.empty()) {
+
+			oldest.swap(newest);
+		}
+
+		box = oldest.front();
+
+		oldest.pop_front();
+	}
+
+	return box;
+}
+
+void spilling_queue::visit(const std::deque<interval*>& boxes, visitor& v) {
+
+	for (size_t i=0; i<boxes.size(); ++i) {
+
+		v.visit(boxes[i], -1);
+	}
+}
+
+void spilling_queue::visit_all(visitor& v) const {
+
+	visit(oldest, v);
+
+	std::vector<interval> box(n_vars);
+
+	for (size_t k=0; k<segments.size(); ++k) {
+
+		const double* record = file.segment(segments[k].slot);
+
+		for (int i=0; i<segments[k].count; ++i, record+=record_size) {
+
+			unpack(record, n_vars, &box.at(0));
+
+			v.visit(&box.at(0), static_cast<int>(record[2*n_vars]));
+		}
+	}
+
+	visit(newest, v);
+}
+
+}
@@ -20,6 +20,7 @@
 //
 //==============================================================================
 
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include "glpk_impl.hpp"
@@ -51,6 +52,8 @@ glpk_impl::glpk_impl() {
 
 	previous_itr_count = 0;
 
+	next_row = 1;
+
 	init();
 }
 
@@ -61,6 +64,25 @@ glpk_impl::~glpk_impl() {
 	glp_delete_prob(lp);
 }
 
+lp_impl* glpk_impl::clone() const {
+
+	glpk_impl* copy = new glpk_impl;
+
+	glp_copy_prob(copy->lp, lp, GLP_OFF);
+
+	*copy->parm = *parm;
+
+	copy->next_row = next_row;
+
+	lp_basis basis;
+
+	save_basis(basis);
+
+	copy->load_basis(basis);
+
+	return copy;
+}
+
 void glpk_impl::free_environment() {
 
 	glp_free_env();
@@ -79,11 +101,41 @@ void glpk_impl::init() {
 
 void glpk_impl::reset() {
 
-	previous_itr_count += lpx_get_int_parm(lp, LPX_K_ITCNT);
+	next_row = 1;
 
-	glp_erase_prob(lp);
+	reset_col_bounds();
 
-	init();
+	glp_set_obj_dir(lp, GLP_MIN);
+}
+
+// Fixed at zero means unset for set_col_bounds(), as for new columns
+void glpk_impl::reset_col_bounds() {
+
+	const int n = glp_get_num_cols(lp);
+
+	for (int j=1; j<=n; ++j) {
+
+		glp_set_col_bnds(lp, j, GLP_FX, 0.0, 0.0);
+	}
+}
+
+void glpk_impl::drop_unused_rows() {
+
+	const int m = glp_get_num_rows(lp);
+
+	if (next_row > m) {
+
+		return;
+	}
+
+	std::vector<int> rows(1, 0);
+
+	for (int i=next_row; i<=m; ++i) {
+
+		rows.push_back(i);
+	}
+
+	glp_del_rows(lp, m-next_row+1, &rows.at(0));
 }
 
 void glpk_impl::add_cols(int n) {
@@ -100,7 +152,9 @@ void glpk_impl::add_eq_row(const int index[], const double value[], int length,
 	//	cout << "index: " << index[i] << ", value: " << value[i] << endl;
 	//}
 
-	const int row_index = glp_add_rows(lp, 1);
+	const int row_index = (next_row <= glp_get_num_rows(lp)) ? next_row : glp_add_rows(lp, 1);
+
+	++next_row;
 
 	glp_set_mat_row(lp, row_index, length, index, value);
 
@@ -224,11 +278,20 @@ void glpk_impl::set_col_dual_status(const int j) {
 
 void glpk_impl::run_simplex() {
 
+	drop_unused_rows();
+
 	scale_prob();
 
 	//make_basis(); // Redundant for PRIMAL, DUAL is unclear
 
-	const int error_code = glp_simplex(lp, parm);
+	int error_code = glp_simplex(lp, parm);
+
+	if (error_code==GLP_EBADB || error_code==GLP_ESING || error_code==GLP_ECOND) {
+
+		glp_adv_basis(lp, 0); // the kept basis does not fit the new rows
+
+		error_code = glp_simplex(lp, parm);
+	}
 
 	if (error_code) {
 
@@ -306,9 +369,57 @@ void glpk_impl::dump(const char* file) const {
 
 void glpk_impl::show_iteration_count() const {
 
-	uint64_t count = previous_itr_count + lpx_get_int_parm(lp, LPX_K_ITCNT);
+	std::cout << "Simplex iterations: " << iteration_count() << std::endl;
+}
+
+uint64_t glpk_impl::iteration_count() const {
 
-	std::cout << "Simplex iterations: " << count << std::endl;
+	return previous_itr_count + lpx_get_int_parm(lp, LPX_K_ITCNT);
+}
+
+void glpk_impl::save_basis(lp_basis& basis) const {
+
+	const int m = glp_get_num_rows(lp);
+
+	const int n = glp_get_num_cols(lp);
+
+	basis.status.resize(m+n);
+
+	for (int i=1; i<=m; ++i) {
+
+		basis.status.at(i-1) = glp_get_row_stat(lp, i);
+	}
+
+	for (int j=1; j<=n; ++j) {
+
+		basis.status.at(m+j-1) = glp_get_col_stat(lp, j);
+	}
+
+	basis.point.clear();
+}
+
+void glpk_impl::load_basis(const lp_basis& basis) {
+
+	drop_unused_rows();
+
+	const int m = glp_get_num_rows(lp);
+
+	const int n = glp_get_num_cols(lp);
+
+	if (static_cast<int>(basis.status.size()) != m+n) {
+
+		return;
+	}
+
+	for (int i=1; i<=m; ++i) {
+
+		glp_set_row_stat(lp, i, basis.status.at(i-1));
+	}
+
+	for (int j=1; j<=n; ++j) {
+
+		glp_set_col_stat(lp, j, basis.status.at(m+j-1));
+	}
 }
 
 int glpk_impl::num_cols() const {
@@ -318,7 +429,7 @@ int glpk_impl::num_cols() const {
 
 int glpk_impl::num_rows() const {
 
-	return glp_get_num_rows(lp);
+	return next_row - 1;
 }
 
 col_status glpk_impl::col_stat(int i) const {
@@ -387,6 +498,89 @@ double glpk_impl::col_dual_val(int i) const {
 	return glp_get_col_dual(lp, i);
 }
 
+double glpk_impl::row_dual_val(int i) const {
+
+	return glp_get_row_dual(lp, i);
+}
+
+// The primal simplex stops in phase 1 with a basis that minimizes the sum
+// of the bound violations of the basic variables. Its duals y = B^-T c_B,
+// with c_B the signs of the violations, combine the rows r = Ax into one
+// that cannot be satisfied. glp_btran() undoes the scaling. The caller
+// verifies the certificate before using it.
+bool glpk_impl::infeasibility_certificate(std::vector<double>& y) const {
+
+	if (!glp_bf_exists(lp)) {
+
+		return false;
+	}
+
+	const int m = glp_get_num_rows(lp);
+
+	std::vector<double> c(m+1, 0.0);
+
+	bool violated = false;
+
+	for (int p=1; p<=m; ++p) {
+
+		c.at(p) = bound_violation(glp_get_bhead(lp, p));
+
+		violated = violated || c.at(p) != 0.0;
+	}
+
+	if (!violated) {
+
+		return false;
+	}
+
+	glp_btran(lp, &c.at(0));
+
+	y.assign(c.begin()+1, c.end());
+
+	return true;
+}
+
+// +1 if the basic variable k is above its upper bound, -1 if below its lower
+// bound, 0 otherwise; rows first, then columns as in glp_get_bhead()
+int glpk_impl::bound_violation(int k) const {
+
+	const int m = glp_get_num_rows(lp);
+
+	const double x  = (k <= m) ? glp_get_row_prim(lp, k) : glp_get_col_prim(lp, k-m);
+
+	const double lb = (k <= m) ? glp_get_row_lb(lp, k)   : glp_get_col_lb(lp, k-m);
+
+	const double ub = (k <= m) ? glp_get_row_ub(lp, k)   : glp_get_col_ub(lp, k-m);
+
+	const double tol = parm->tol_bnd;
+
+	if (x > ub + tol*(1.0 + std::fabs(ub))) {
+
+		return 1;
+	}
+	else if (x < lb - tol*(1.0 + std::fabs(lb))) {
+
+		return -1;
+	}
+
+	return 0;
+}
+
+bool glpk_impl::has_reduced_costs() const {
+
+	return true;
+}
+
+double glpk_impl::primal_tolerance() const {
+
+	return 0.0;
+}
+
+const sparse_rows* glpk_impl::recorded_rows() const {
+
+	return 0;
+}
+
 bool glpk_impl::is_fixed(int index) const {
 
 	return glp_get_col_type(lp, index)==GLP_FX;
@@ -0,0 +1,144 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include "incidence_recorder.hpp"
+#include "diagnostics.hpp"
+
+using namespace std;
+
+namespace asol {
+
+incidence_recorder::incidence_recorder(int number_of_nodes) : n_nodes(number_of_nodes) {
+
+}
+
+void incidence_recorder::record_node(int index) {
+
+	ASSERT2(0<=index && index<n_nodes, "index, n_nodes: "<<index<<", "<<n_nodes);
+
+	current.insert(index);
+}
+
+void incidence_recorder::finish_constraint() {
+
+	ASSERT2(!current.empty(),"constraint without primitives");
+
+	nodes.push_back(vector<int>(current.begin(), current.end()));
+
+	current.clear();
+}
+
+const vector<vector<int> >& incidence_recorder::constraint_nodes() const {
+
+	ASSERT2(current.empty(),"last constraint is not finished");
+
+	return nodes;
+}
+
+const vector<vector<int> > incidence_recorder::node_constraints() const {
+
+	ASSERT2(current.empty(),"last constraint is not finished");
+
+	vector<vector<int> > result(n_nodes);
+
+	const int m = static_cast<int> (nodes.size());
+
+	for (int k=0; k<m; ++k) {
+
+		const vector<int>& con = nodes.at(k);
+
+		for (size_t i=0; i<con.size(); ++i) {
+
+			result.at(con.at(i)).push_back(k);
+		}
+	}
+
+	return result;
+}
+
+void incidence_recorder::addition(int z, int x, int y) {
+
+	record_node(z);
+	record_node(x);
+	record_node(y);
+}
+
+void incidence_recorder::substraction(int z, int x, int y) {
+
+	record_node(z);
+	record_node(x);
+	record_node(y);
+}
+
+void incidence_recorder::multiplication(int z, int x, int y) {
+
+	record_node(z);
+	record_node(x);
+	record_node(y);
+}
+
+void incidence_recorder::division(int z, int x, int y) {
+
+	record_node(z);
+	record_node(x);
+	record_node(y);
+}
+
+void incidence_recorder::square(int z, int x) {
+
+	record_node(z);
+	record_node(x);
+}
+
+void incidence_recorder::exponential(int z, int x) {
+
+	record_node(z);
+	record_node(x);
+}
+
+void incidence_recorder::logarithm(int z, int x) {
+
+	record_node(z);
+	record_node(x);
+}
+
+void incidence_recorder::equality_constraint(int z, int , double ) {
+
+	record_node(z); // the second argument is the constraint offset, not a node
+}
+
+void incidence_recorder::common_subexpression(int z, int ) {
+
+	record_node(z); // the second argument is an ordinal, not a node
+}
+
+void incidence_recorder::less_than_or_equal_to(int z, int x) {
+
+	record_node(z);
+	record_node(x);
+}
+
+incidence_recorder::~incidence_recorder() {
+	// Out-of-line dtor just to make the compiler shut up
+}
+
+}
@@ -26,20 +26,11 @@
 #include <iosfwd>
 #include <vector>
 #include "interval.hpp"
+#include "noise_arena.hpp"
+#include "solver_context.hpp"
 
 namespace asol {
 
-struct epsilon {
-
-	epsilon() : index(-1), coeff(1.0e+300) { }
-
-	epsilon(int i, double c) : index(i), coeff(c) { }
-
-	int    index;
-
-	double coeff;
-};
-
 class lp_solver;
 
 class affine {
@@ -92,7 +83,15 @@ public:
 
 	static void reset_counter();
 
-	friend class affine_pair_iterator;
+	// At most k noise symbols of the non-variables per form, 0 means no limit
+	static void set_noise_term_limit(int k);
+
+	static void keep_noise_terms();
+
+	static void release_noise_terms();
+
+	template <typename Op>
+	friend void merge_noise_terms(const affine& x, const affine& y, Op& op);
 
 	template <typename> friend class binary_operation;
 
@@ -100,17 +99,21 @@ public:
 
 	const interval range() const { return get_range(); }
 
+	int number_of_noise_terms() const { return size()-1; }
+
 	const interval merge() const;
 
 private:
 
-	explicit affine(const interval& range) : range_index(-1), ia_range(range) { }
+	// Temporaries keep their noise terms in the buffer as long as they fit
+	affine(const interval& range, epsilon* buffer, int size)
+	: noise_vars(buffer, size), range_index(-1), ia_range(range) { }
 
 	int size() const { return static_cast<int>(noise_vars.size()); }
 
-	interval& get_range() {	return range_index>=0 ? v->at(range_index) : ia_range; }
+	interval& get_range() {	return range_index>=0 ? ranges()->at(range_index) : ia_range; }
 
-	const interval& get_range() const { return range_index>=0 ? v->at(range_index) : ia_range; }
+	const interval& get_range() const { return range_index>=0 ? ranges()->at(range_index) : ia_range; }
 
 	double  central_value() const { return noise_vars.at(0).coeff; }
 
@@ -128,19 +131,24 @@ private:
 
 	void condense_last_two_noise_vars();
 
-	std::vector<epsilon> noise_vars;
+	void limit_noise_terms();
+
+	noise_terms noise_vars;
 
 	int range_index;
 
 	interval ia_range;
 
-	static int max_used_index;
+	// These live in the current solver_context
+	static int& max_used_index() { return solver_context::current().max_used_index; }
+
+	static int& last_variable_index() { return solver_context::current().last_variable_index; }
 
-	static std::vector<interval>* v;
+	static std::vector<interval>* ranges() { return solver_context::current().affine_ranges; }
 
-	static lp_solver* lp;
+	static lp_solver* lp() { return solver_context::current().lp; }
 
-	static bool excellent_progress_made;
+	static bool& excellent_progress_made() { return solver_context::current().excellent_progress_made; }
 
 	static const double NARROW;
 };
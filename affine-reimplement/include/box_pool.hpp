@@ -0,0 +1,104 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef BOX_POOL_HPP_
+#define BOX_POOL_HPP_
+
+#include <cstddef>
+#include "threads.hpp"
+
+namespace asol {
+
+class interval;
+
+// Fixed size slabs of n_vars intervals for the pending boxes, carved from
+// large chunks; each slab starts on a cache line. Released slabs go on a
+// lock-free freelist (Treiber stack) shared by all threads; its head holds
+// a slot index and a tag that is bumped on every change against ABA. Only
+// adding a new chunk takes the lock, the chunks are freed in the dtor. At
+// most MAX_CHUNKS*1024 boxes can be live, allocate() throws bad_alloc then.
+class box_pool {
+
+public:
+
+	explicit box_pool(int n_vars);
+
+	interval* allocate();
+
+	void release(interval* box);
+
+	int boxes_in_use() const { return in_use; }
+
+	int peak_boxes() const { return peak; }
+
+	std::size_t memory() const; // bytes in the chunks, not synchronized
+
+	~box_pool();
+
+private:
+
+	box_pool(const box_pool& );
+	box_pool& operator=(const box_pool& );
+
+	typedef unsigned long long word; // tag in the high, slot+1 in the low half
+
+	struct slab_header { // after the intervals of the slab
+		int slot;
+		int next; // on the freelist, -1 at the end
+	};
+
+	enum { MAX_CHUNKS = 4096 };
+
+	char* slab(int slot) const;
+
+	slab_header* header(int slot) const;
+
+	interval* new_slab();
+
+	interval* construct_box(int slot);
+
+	void count_allocation();
+
+	const int n_vars;
+
+	const std::size_t stride; // bytes per slab
+
+	volatile word free_head;
+
+	volatile int in_use;
+
+	volatile int peak;
+
+	mutex chunk_lock; // guards the members below
+
+	char* chunks[MAX_CHUNKS]; // cache line aligned
+
+	char* raw_chunks[MAX_CHUNKS];
+
+	int n_chunks;
+
+	int unused_slot; // the first never allocated one
+};
+
+}
+
+#endif // BOX_POOL_HPP_
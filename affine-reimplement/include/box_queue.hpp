@@ -0,0 +1,120 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef BOX_QUEUE_HPP_
+#define BOX_QUEUE_HPP_
+
+#include <cstddef>
+
+namespace asol {
+
+class interval;
+struct split_node;
+
+enum search_order {
+	BREADTH_FIRST,
+	DEPTH_FIRST,
+	BEST_FIRST,
+	HYBRID        // best-first, depth-first while over the memory budget
+};
+
+enum box_heuristic {
+	SMALLEST_MAX_WIDTH,
+	SMALLEST_RESIDUAL   // widest interval residual of the constraints
+};
+
+struct search_options {
+
+	search_options();
+
+	search_order order;
+
+	box_heuristic heuristic; // of BEST_FIRST and HYBRID
+
+	std::size_t memory_budget; // in bytes, of the boxes in the queue of HYBRID
+
+	bool compact_frontier; // the pending boxes are kept in a split_tree
+
+	// Bytes of boxes kept in memory by BREADTH_FIRST and DEPTH_FIRST, the
+	// rest goes to spill_file; 0 if unlimited, see spilling_queue. Not
+	// supported by the other orders and by the compact frontier.
+	std::size_t ram_budget;
+
+	const char* spill_file; // 0 for a unique temporary file, the default
+};
+
+// The pending boxes of the serial search, either the boxes themselves or
+// their split_tree nodes. The priority is only used by the best-first
+// queues, the box with the smallest priority is popped first; ties are
+// broken in the order of the pushes.
+template <typename T>
+class box_queue {
+
+public:
+
+	static box_queue* new_queue(const search_options& options, int n_vars);
+
+	virtual void push(T* box, double priority) = 0;
+
+	virtual T* pop() = 0;
+
+	virtual int size() const = 0;
+
+	class visitor {
+
+	public:
+
+		// The tag of a spilled box, see spill_observer; -1 for the boxes in memory
+		virtual void visit(const T* box, int tag) = 0;
+
+	protected:
+
+		~visitor() { }
+	};
+
+	// In the order of the pushes: pushing the boxes again into an empty queue
+	// of the same kind restores the order, except the dives of HYBRID
+	virtual void visit_all(visitor& v) const = 0;
+
+	bool empty() const { return size() == 0; }
+
+	int peak_size() const { return peak; }
+
+	virtual ~box_queue();
+
+protected:
+
+	box_queue();
+
+	void update_peak();
+
+private:
+
+	box_queue(const box_queue& );
+	box_queue& operator=(const box_queue& );
+
+	int peak;
+};
+
+}
+
+#endif // BOX_QUEUE_HPP_
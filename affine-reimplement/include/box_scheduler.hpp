@@ -0,0 +1,90 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef BOX_SCHEDULER_HPP_
+#define BOX_SCHEDULER_HPP_
+
+#include <deque>
+#include <vector>
+#include "threads.hpp"
+
+namespace asol {
+
+class box_pool;
+class interval;
+
+// Work-stealing deques of pending boxes, one per worker. A worker pushes
+// and pops at the back of its own deque (depth-first), an idle worker
+// steals from the front of the others (the oldest, largest boxes).
+class box_scheduler {
+
+public:
+
+	box_scheduler(int number_of_workers, int n_vars);
+
+	// The boxes of all workers are allocated from here
+	box_pool* boxes() const { return pool; }
+
+	void push(int worker, interval* box);
+
+	// Blocks until a box is available; returns 0 if the search is finished
+	interval* pop(int worker);
+
+	// Must be called after the children of the popped box are pushed
+	void box_done();
+
+	int steals() const { return steal_counter; }
+
+	~box_scheduler();
+
+private:
+
+	box_scheduler(const box_scheduler& );
+	box_scheduler& operator=(const box_scheduler& );
+
+	interval* pop_own(int worker);
+	interval* steal(int thief);
+
+	void took_box();
+
+	const int n_workers;
+
+	box_pool* const pool;
+
+	std::vector<std::deque<interval*> > queues;
+
+	std::vector<mutex*> queue_locks;
+
+	mutex state_lock; // guards the counters below
+
+	condition work_available;
+
+	int queued;    // boxes in the deques
+
+	int in_flight; // popped but not done yet
+
+	int steal_counter;
+};
+
+}
+
+#endif // BOX_SCHEDULER_HPP_
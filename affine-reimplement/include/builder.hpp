@@ -79,7 +79,7 @@ private:
 
 	explicit builder(double );
 
-	static problem_data* problem;
+	static problem_data*& problem(); // of the current solver_context
 
 	int index;
 };
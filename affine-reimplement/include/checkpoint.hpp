@@ -0,0 +1,122 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef CHECKPOINT_HPP_
+#define CHECKPOINT_HPP_
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "interval.hpp"
+
+namespace asol {
+
+// State of the serial search between two boxes, followed by the pending
+// boxes in the file. The hints of the pending boxes (LP warm starts, node
+// enclosures) and the statistics of the contractor_scheduler are not saved.
+struct checkpoint_header {
+
+	int n_vars;
+
+	std::string strategy; // type of the splitting_strategy, it has no state
+
+	int solutions_found;
+
+	int splits;
+
+	int boxes_processed;
+
+	int splits_to_first_solution;
+
+	int solutions_proved;
+
+	std::vector<int> found_counters; // of the known solutions, see sol_tracker
+
+	std::vector<interval> solutions; // the converged boxes, n_vars each
+
+	int pending_boxes;
+};
+
+// Writes file.tmp and renames it in commit(): a crash while writing leaves
+// the previous checkpoint intact. The boxes are streamed, so that a spilled
+// frontier need not fit in the memory.
+class checkpoint_writer {
+
+public:
+
+	checkpoint_writer(const char* file, const checkpoint_header& header);
+
+	void add_box(const interval* box, int depth);
+
+	void commit();
+
+	~checkpoint_writer(); // the temporary file is removed if not committed
+
+private:
+
+	checkpoint_writer(const checkpoint_writer& );
+	checkpoint_writer& operator=(const checkpoint_writer& );
+
+	const std::string file;
+
+	const std::string tmp;
+
+	const int n_vars;
+
+	const int pending_boxes;
+
+	std::vector<double> record;
+
+	FILE* out;
+
+	int written;
+};
+
+class checkpoint_reader {
+
+public:
+
+	explicit checkpoint_reader(const char* file);
+
+	const checkpoint_header& header() const { return head; }
+
+	// False after the last pending box
+	bool next_box(interval* box, int& depth);
+
+private:
+
+	checkpoint_reader(const checkpoint_reader& );
+	checkpoint_reader& operator=(const checkpoint_reader& );
+
+	std::ifstream in;
+
+	checkpoint_header head;
+
+	std::vector<double> record;
+
+	int read;
+};
+
+}
+
+#endif // CHECKPOINT_HPP_
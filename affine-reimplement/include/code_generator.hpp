@@ -0,0 +1,98 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef CODE_GENERATOR_HPP_
+#define CODE_GENERATOR_HPP_
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "recorder.hpp"
+
+namespace asol {
+
+class interval;
+class problem_data;
+
+// Emits a standalone kernel for a recorded problem: straight-line forward
+// evaluation for interval and affine, and backward revision for interval,
+// with all indices baked in. The result is meant to be compiled into a
+// model specific solver, see examples/Jacobsen_kernel.cpp for an example.
+class code_generator : public recorder {
+
+public:
+
+	code_generator(const problem_data* problem, const std::string& name);
+
+	void write_header(std::ostream& out) const;
+
+	void write_source(std::ostream& out) const;
+
+	void write_files(const std::string& directory) const;
+
+	~code_generator();
+
+private:
+
+	code_generator(const code_generator& );
+	code_generator& operator=(const code_generator& );
+
+	virtual void addition      (int z, int x, int y);
+	virtual void substraction  (int z, int x, int y);
+	virtual void multiplication(int z, int x, int y);
+	virtual void division      (int z, int x, int y);
+
+	virtual void square     (int z, int x);
+	virtual void exponential(int z, int x);
+	virtual void logarithm  (int z, int x);
+
+	virtual void equality_constraint(int z, int x, double val);
+	virtual void common_subexpression(int z, int x);
+	virtual void less_than_or_equal_to(int z, int x);
+
+	const std::string guard() const;
+	const std::string kernel_namespace() const;
+
+	void write_set_box(std::ostream& out) const;
+	void write_evaluate(std::ostream& out) const;
+	void write_revise(std::ostream& out) const;
+
+	const std::string name;
+	const int n_vars;
+	const int n_nodes;
+	const std::vector<std::pair<int,double> > constants;
+
+	std::vector<std::string> forward_sweep;
+	std::vector<std::string> backward_sweep; // in recording order
+};
+
+// The interval part of a generated kernel, handy for testing and benchmarks
+struct generated_kernel {
+	int number_of_nodes;
+	void (*set_box)(interval* v, const interval* box);
+	void (*evaluate)(interval* v);
+	void (*revise)(interval* v);
+};
+
+}
+
+#endif // CODE_GENERATOR_HPP_
@@ -0,0 +1,118 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef CONTRACTOR_SCHEDULER_HPP_
+#define CONTRACTOR_SCHEDULER_HPP_
+
+#include <vector>
+
+namespace asol {
+
+enum contractor {
+	IA_REVISION,
+	NEWTON_STEP,  // interval Newton, iterated while it proves uniqueness
+	LP_STAGE,     // affine evaluation, LP feasibility check and LP pruning
+	N_CONTRACTORS
+};
+
+enum lp_policy {
+	LP_ALWAYS,   // the default
+	LP_NEVER,
+	LP_ADAPTIVE  // measured in wall-clock time, the search is not reproducible
+};
+
+struct scheduling_options {
+
+	scheduling_options();
+
+	lp_policy policy;
+
+	// The box is contracted again if a variable shrank below this ratio
+	double sufficient_reduction;
+
+	// The LP stage is skipped at a depth where its recent gain is lower
+	double min_gain_per_ms;
+
+	// LP stages run at each depth before the first one is skipped
+	int warm_up;
+
+	// Every probe_interval-th skipped LP stage is run anyway
+	int probe_interval;
+
+	// Weight of the latest sample in the running average of the gain
+	double decay;
+};
+
+// Measures each contractor on each box: the gain is 1 minus the best ratio
+// of the new and old diameters, 1 if the box is discarded. The statistics
+// are kept per split depth as the boxes at the same depth behave alike.
+class contractor_scheduler {
+
+public:
+
+	explicit contractor_scheduler(const scheduling_options& options);
+
+	bool run_lp_stage(int depth);
+
+	void start(contractor c);
+
+	// Reduction is the best new / old diameter ratio, 0 if the box is discarded
+	void finish(contractor c, int depth, double reduction);
+
+	// The LP stage is kept on at that depth, see affine::excellent_progress_made
+	void excellent_progress(int depth);
+
+	bool sufficient(double reduction) const;
+
+	void print_statistics() const;
+
+private:
+
+	struct depth_stats {
+
+		depth_stats();
+
+		int samples[N_CONTRACTORS];
+
+		double gain_per_ms[N_CONTRACTORS]; // running average
+
+		double total_gain[N_CONTRACTORS];
+
+		double total_ms[N_CONTRACTORS];
+
+		int skipped;
+
+		int skip_streak;
+	};
+
+	depth_stats& at(int depth);
+
+	const scheduling_options options;
+
+	std::vector<depth_stats> stats;
+
+	double start_time[N_CONTRACTORS];
+};
+
+}
+
+#endif // CONTRACTOR_SCHEDULER_HPP_
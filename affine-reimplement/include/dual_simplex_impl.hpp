@@ -0,0 +1,190 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef DUAL_SIMPLEX_IMPL_HPP_
+#define DUAL_SIMPLEX_IMPL_HPP_
+
+#include <vector>
+#include <stdint.h>
+#include "lp_impl.hpp"
+
+namespace asol {
+
+// Bounded-variable dual simplex for the small and dense LPs of lp_solver.
+// Row i is a_i*x - r_i = 0 with the row activity r_i bounded like any
+// column, hence every variable is boxed and any basis is dual feasible
+// once the nonbasic variables are put at the bound matching the sign of
+// their reduced costs. The explicit basis inverse is updated in product
+// form and refactored periodically; the basis is kept across solves.
+class dual_simplex_impl : public lp_impl {
+
+public:
+
+	dual_simplex_impl();
+
+private:
+
+	virtual ~dual_simplex_impl();
+
+	virtual void reset();
+
+	virtual lp_impl* clone() const;
+
+	virtual void add_cols(int n);
+
+	// index[1] ... index[length]
+	virtual void add_eq_row(const int index[], const double value[], int length, double lb, double ub);
+
+	virtual void set_col_bounds(int index, double lb, double ub);
+
+	virtual void run_simplex();
+
+	virtual double tighten_col_lb(int i, const double lb);
+
+	virtual double tighten_col_ub(int i, const double ub);
+
+	virtual int num_cols() const;
+
+	virtual int num_rows() const;
+
+	virtual col_status col_stat(int i) const;
+
+	virtual double col_val(int i) const;
+
+	virtual double col_lb(int i) const;
+
+	virtual double col_ub(int i) const;
+
+	virtual double col_dual_val(int i) const;
+
+	virtual double row_dual_val(int i) const;
+
+	virtual bool infeasibility_certificate(std::vector<double>& y) const;
+
+	virtual bool has_reduced_costs() const;
+
+	virtual double primal_tolerance() const;
+
+	virtual const sparse_rows* recorded_rows() const;
+
+	virtual bool is_fixed(int index) const;
+
+	virtual void dump(const char* file) const;
+
+	virtual void show_iteration_count() const;
+
+	virtual uint64_t iteration_count() const;
+
+	virtual void save_basis(lp_basis& basis) const;
+
+	virtual void load_basis(const lp_basis& basis);
+
+	//===================================
+
+	dual_simplex_impl(const dual_simplex_impl& other);
+
+	dual_simplex_impl& operator=(const dual_simplex_impl& );
+
+	void drop_unused_rows();
+
+	void make_slack_basis();
+
+	bool factorize();
+
+	void refactor();
+
+	void compute_reduced_costs();
+
+	void compute_basic_values();
+
+	void solve(int index, double direction);
+
+	void iterate();
+
+	void perturb_costs();
+
+	void run_dual_phase();
+
+	int select_leaving_row() const;
+
+	int select_entering_var(double s) const;
+
+	void compute_pivot_row(int r);
+
+	void compute_pivot_col(int q);
+
+	double pivot(int r, int q, double s);
+
+	bool is_boxed(int k) const;
+
+	void check_col_index(int i) const;
+
+	//===================================
+
+	enum var_status {
+		AT_LB,
+		AT_UB,
+		IN_BASIS
+	};
+
+	int n; // structural columns, the epsilons
+	int m; // rows, the row activities are the variables n ... n+m-1
+
+	int next_row; // add_eq_row() overwrites this row, appends if past the end
+
+	std::vector<double> A; // Row-major coefficients of the structurals, A[i*n+j]
+
+	std::vector<double> lb;   // Bounds, values, reduced costs and objective
+	std::vector<double> ub;   // of all the n+m variables
+	std::vector<double> x;
+	std::vector<double> d;
+	std::vector<double> cost;
+	std::vector<double> obj; // cost, perturbed while iterating
+
+	std::vector<int> status; // var_status of each variable
+
+	std::vector<int> head; // Basic variable of each row
+
+	std::vector<double> B_inv; // Row-major explicit inverse of the basis, m x m
+
+	std::vector<double> alpha_row; // Row r of B_inv*[A -I], all variables
+
+	std::vector<double> alpha_col; // B_inv times the column of the entering var
+
+	// Row r of B_inv if row r proved the last LP infeasible: its basic
+	// variable cannot reach its bounds whatever the nonbasic ones are
+	std::vector<double> farkas_ray;
+
+	bool factorized;
+
+	bool perturbed; // obj differs from cost
+
+	int eta_count; // Updates since the last factorization
+
+	double sense; // 1 if the last LP was a minimization, -1 if maximization
+
+	uint64_t itr_count;
+};
+
+}
+
+#endif // DUAL_SIMPLEX_IMPL_HPP_
@@ -23,8 +23,11 @@
 #ifndef EXPRESSION_GRAPH_HPP_
 #define EXPRESSION_GRAPH_HPP_
 
+#include <deque>
 #include <iosfwd>
+#include <utility>
 #include <vector>
+#include "tape.hpp"
 #include "typedefs.hpp"
 
 namespace asol {
@@ -34,6 +37,24 @@ template <typename T> class primitive;
 class sol_tracker;
 class problem_data;
 
+// The contracted enclosures of a box, the children of the box start their
+// revision from them after a split; of the other nodes, only those tighter
+// than ANY_REAL() are kept. This is not a delta against the parent's store:
+// each pending box holds O(nodes) of them, around 260 nodes per box on
+// Jacobsen, which is why search_procedure keeps the inheritance off by
+// default.
+template <typename T>
+struct node_enclosures {
+
+	std::vector<T> vars; // at the end of the last iterative revision, may be empty
+
+	std::vector<std::pair<int,T> > nodes;
+};
+
+enum revision_strategy {
+	PREFIX_SWEEP,        // revise constraints 0..pos for each pos, quadratic
+	CONSTRAINT_WORKLIST  // requeue constraints only if their nodes shrank
+};
 
 template <typename T>
 class expression_graph {
@@ -49,6 +70,12 @@ public:
 
 	void set_box(const T* box, const int length);
 
+	// The next worklist revision starts from the constraints of the variables
+	// that differ from enclosures.vars, from all of them if it is empty
+	void set_box(const T* box, const int length, const node_enclosures<T>& enclosures);
+
+	void save_enclosures(node_enclosures<T>& enclosures) const;
+
 	void reset_vars();
 
 	const T* get_box() const;
@@ -63,6 +90,12 @@ public:
 
 	void iterative_revision();
 
+	void set_revision_strategy(revision_strategy strategy);
+
+	void set_requeue_threshold(double relative_reduction);
+
+	int constraint_revisions() const;
+
 	void iterative_revision_save_gaps();
 
 	void probing();
@@ -102,6 +135,8 @@ private:
 
 	int constraints_size() const { return static_cast<int> (constraints.size()); }
 
+	int last_primitive() const { return tape.size()-1; }
+
 	void set_variables();
 	void set_non_variables();
 	void set_numeric_consts();
@@ -116,6 +151,14 @@ private:
 	void revise_up_to(const int i);
 	void revise_constraint(int i);
 
+	void init_incidence();
+	void prefix_sweep();
+	void worklist_revision();
+	void enqueue(int i);
+	void save_snapshot(int i);
+	void requeue_neighbors(int i);
+	bool shrunk(const T& before, const T& after) const;
+
 	void probe_in_constraint(const int i);
 	void revise_up_to_with_hull_saved(const int i);
 	void iterative_revise_with_hull_saved();
@@ -131,6 +174,7 @@ private:
 	std::vector<T> v;
 	const int n_vars;
 	const PrimVector primitives;
+	const tape_interpreter<T> tape;
 	const PairVector constants;
 	const BoundVector initial_box;
 	const IntArray2D index_sets;
@@ -142,6 +186,21 @@ private:
 	std::vector<T> hull;
 
 	std::vector<gap_info<T> > gaps;
+
+	revision_strategy strategy;
+	double requeue_threshold;
+	int revision_counter;
+
+	IntArray2D constraint_nodes;
+	IntArray2D node_constraints;
+
+	std::deque<int> worklist;
+	std::vector<char> queued;
+	std::vector<T> snapshot;
+
+	std::vector<T> revised_vars;
+	IntVector seeds;
+	bool seeded;
 };
 
 }
@@ -0,0 +1,69 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef FARKAS_CACHE_HPP_
+#define FARKAS_CACHE_HPP_
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace asol {
+
+struct sparse_rows;
+
+// Bounded cache of the row multipliers that proved earlier LPs infeasible.
+// The LP of each box is built from the same constraints in the same order,
+// so the certificate of a box often proves its siblings infeasible too; it
+// is checked with directed rounding in O(nnz) instead of solving the LP.
+// The columns are assumed to be in [-1, 1].
+class farkas_cache {
+
+public:
+
+	explicit farkas_cache(int capacity);
+
+	// Stored only if y proves the rows infeasible, the oldest certificate is
+	// evicted if the cache is full; y[k] belongs to row k
+	void add(const std::vector<double>& y, const sparse_rows& rows, int n_cols);
+
+	// The certificate that proves the rows infeasible is moved to the front
+	bool proves_infeasible(const sparse_rows& rows, int n_cols);
+
+	int hits() const { return hit_count; }
+
+private:
+
+	typedef std::vector<std::pair<int,double> > certificate; // (row, y)
+
+	static bool proves(const certificate& y, const sparse_rows& rows, int n_cols);
+
+	const int capacity;
+
+	std::deque<certificate> certificates;
+
+	int hit_count;
+};
+
+}
+
+#endif // FARKAS_CACHE_HPP_
@@ -0,0 +1,170 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef FRONTIER_SPILL_HPP_
+#define FRONTIER_SPILL_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+#include "box_queue.hpp"
+
+namespace asol {
+
+class box_pool;
+
+// Fixed size segments in a memory-mapped file; the file grows by doubling
+// and is removed in the dtor. The pointers to the segments are invalidated
+// by new_segment().
+class spill_file {
+
+public:
+
+	// A named file is overwritten; if name is 0, a unique file is created in
+	// TMPDIR (or /tmp) and unlinked at once, it is only reachable through fd
+	spill_file(const char* name, std::size_t segment_bytes);
+
+	int new_segment();
+
+	double* segment(int slot) const;
+
+	void release_segment(int slot);
+
+	std::size_t size() const { return capacity*segment_bytes; } // in bytes
+
+	~spill_file();
+
+private:
+
+	spill_file(const spill_file& );
+	spill_file& operator=(const spill_file& );
+
+	void grow();
+
+	std::string name;
+
+	const bool temporary;
+
+	const std::size_t segment_bytes;
+
+	int fd;
+
+	char* base;
+
+	int capacity; // in segments
+
+	int used; // segments ever handed out
+
+	std::vector<int> free_slots;
+};
+
+// Notified as the boxes leave and re-enter the memory. The tag is saved
+// along with the box and given back when the box is read in.
+class spill_observer {
+
+public:
+
+	virtual int box_spilled(const interval* box) = 0;
+
+	virtual void box_restored(const interval* box, int tag) = 0;
+
+protected:
+
+	~spill_observer() { }
+};
+
+// Breadth-first or depth-first queue that keeps at most ram_budget bytes
+// of boxes in the pool; the coldest boxes in memory are written to the
+// spill file in segments and read back in order when they are due. The
+// slabs of the spilled boxes are released, the restored boxes get new
+// ones.
+class spilling_queue : public box_queue<interval> {
+
+public:
+
+	spilling_queue(const search_options& options, int n_vars, box_pool* pool, spill_observer* observer);
+
+	virtual void push(interval* box, double priority);
+
+	virtual interval* pop();
+
+	virtual int size() const;
+
+	// The spilled boxes are read into a temporary buffer
+	virtual void visit_all(visitor& v) const;
+
+	int spilled_segments() const { return spills; }
+
+	std::size_t file_size() const { return file.size(); }
+
+private:
+
+	struct segment {
+
+		segment(int s, int n) : slot(s), count(n) { }
+
+		int slot;
+
+		int count;
+	};
+
+	int in_memory() const;
+
+	void spill();
+
+	segment write(std::deque<interval*>& boxes, bool from_front);
+
+	void restore(const segment& s, std::deque<interval*>& boxes);
+
+	static void visit(const std::deque<interval*>& boxes, visitor& v);
+
+	const bool lifo;
+
+	const int n_vars;
+
+	const int record_size; // in doubles, the bounds and the tag
+
+	const int max_boxes; // in memory
+
+	const int segment_boxes;
+
+	box_pool* const pool;
+
+	spill_observer* const observer;
+
+	spill_file file;
+
+	std::deque<interval*> oldest; // breadth-first only, popped first
+
+	std::deque<interval*> newest;
+
+	std::deque<segment> segments; // in queue order, between oldest and newest
+
+	int spilled_boxes;
+
+	int spills;
+};
+
+}
+
+#endif // FRONTIER_SPILL_HPP_
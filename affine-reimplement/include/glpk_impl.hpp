@@ -41,6 +41,8 @@ private:
 
 	virtual void reset();
 
+	virtual lp_impl* clone() const;
+
 	virtual void add_cols(int n);
 
 	// index[1] ... index[length]
@@ -68,12 +70,28 @@ private:
 
 	virtual double col_dual_val(int i) const;
 
+	virtual double row_dual_val(int i) const;
+
+	virtual bool infeasibility_certificate(std::vector<double>& y) const;
+
+	virtual bool has_reduced_costs() const;
+
+	virtual double primal_tolerance() const;
+
+	virtual const sparse_rows* recorded_rows() const;
+
 	virtual bool is_fixed(int index) const;
 
 	virtual void dump(const char* file) const;
 
 	virtual void show_iteration_count() const;
 
+	virtual uint64_t iteration_count() const;
+
+	virtual void save_basis(lp_basis& basis) const;
+
+	virtual void load_basis(const lp_basis& basis);
+
 	static void free_environment();
 
 	//===================================
@@ -96,6 +114,12 @@ private:
 
 	double solve_for(int index, int direction);
 
+	void drop_unused_rows();
+
+	void reset_col_bounds();
+
+	int bound_violation(int k) const;
+
 	//===================================
 
 	glp_prob* lp;
@@ -103,6 +127,8 @@ private:
 	glp_smcp* parm;
 
 	uint64_t previous_itr_count;
+
+	int next_row; // add_eq_row() overwrites this row, appends if past the end
 };
 
 }
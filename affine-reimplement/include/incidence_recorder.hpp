@@ -0,0 +1,74 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef INCIDENCE_RECORDER_HPP_
+#define INCIDENCE_RECORDER_HPP_
+
+#include <set>
+#include <vector>
+#include "recorder.hpp"
+
+namespace asol {
+
+// Collects the nodes of the DAG touched by each constraint; the caller must
+// call finish_constraint() after the last primitive of each constraint
+class incidence_recorder : public recorder {
+
+public:
+
+	explicit incidence_recorder(int number_of_nodes);
+
+	void finish_constraint();
+
+	const std::vector<std::vector<int> >& constraint_nodes() const;
+
+	const std::vector<std::vector<int> > node_constraints() const;
+
+	~incidence_recorder();
+
+private:
+
+	virtual void addition      (int z, int x, int y);
+	virtual void substraction  (int z, int x, int y);
+	virtual void multiplication(int z, int x, int y);
+	virtual void division      (int z, int x, int y);
+
+	virtual void square     (int z, int x);
+	virtual void exponential(int z, int x);
+	virtual void logarithm  (int z, int x);
+
+	virtual void equality_constraint(int z, int x, double val);
+	virtual void common_subexpression(int z, int x);
+	virtual void less_than_or_equal_to(int z, int x);
+
+	void record_node(int index);
+
+	const int n_nodes;
+
+	std::set<int> current;
+
+	std::vector<std::vector<int> > nodes; // nodes touched by constraint i
+};
+
+}
+
+#endif // INCIDENCE_RECORDER_HPP_
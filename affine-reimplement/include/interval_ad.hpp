@@ -0,0 +1,128 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef INTERVAL_AD_HPP_
+#define INTERVAL_AD_HPP_
+
+#include <utility>
+#include <vector>
+#include "interval.hpp"
+#include "tape.hpp"
+#include "typedefs.hpp"
+
+namespace asol {
+
+class problem_data;
+
+// Row k holds the nonzero partial derivatives of constraint k, sorted by
+// the variable index
+struct interval_jacobian {
+
+	interval_jacobian() : start(1, 0) { }
+
+	int rows() const { return static_cast<int>(start.size())-1; }
+
+	void add(int j, const interval& d) { col.push_back(j); val.push_back(d); }
+
+	void finish_row() { start.push_back(static_cast<int>(col.size())); }
+
+	void clear() { start.assign(1, 0); col.clear(); val.clear(); }
+
+	std::vector<int> start; // row k is [start[k], start[k+1])
+
+	std::vector<int> col;
+
+	std::vector<interval> val;
+};
+
+// Interval automatic differentiation on the tape of the problem. The
+// residual of constraint k is its body minus its right hand side. The
+// enclosures are recomputed over the box; the revised node values of the
+// expression_graph only hold for the solutions in the box, so they cannot
+// be used for the mean value form. All functions return false if an
+// operation is undefined on the box, e.g. a division by an interval
+// containing zero.
+class interval_ad {
+
+public:
+
+	explicit interval_ad(const problem_data* problem);
+
+	// As many constraints as variables, and all of them are equalities
+	bool square_system() const;
+
+	int number_of_constraints() const { return static_cast<int>(body.size()); }
+
+	bool residuals(const interval* box, std::vector<interval>& f);
+
+	// Gradients of all nodes in one forward sweep
+	bool jacobian_forward(const interval* box, interval_jacobian& J);
+
+	// One backward sweep per constraint
+	bool jacobian_reverse(const interval* box, interval_jacobian& J);
+
+private:
+
+	typedef std::vector<std::pair<int,interval> > gradient; // (variable, derivative)
+
+	bool evaluate(const interval* box);
+
+	bool evaluate(const tape_record& r);
+
+	void differentiate(const tape_record& r);
+
+	void propagate_adjoint(const tape_record& r);
+
+	void accumulate(int node, const interval& d);
+
+	static void combine(const gradient& x, const interval& cx, const gradient& y, const interval& cy, gradient& z);
+
+	static void scale(const gradient& x, const interval& cx, gradient& z);
+
+	const std::vector<tape_record> tape;
+
+	const int n_vars;
+
+	const int n_nodes;
+
+	const std::vector<std::pair<int,double> > constants;
+
+	IntVector body; // node of the body of each equality constraint
+
+	IntVector position; // of each equality constraint on the tape
+
+	std::vector<double> rhs;
+
+	bool equalities_only;
+
+	std::vector<interval> v;
+
+	std::vector<gradient> grad;
+
+	std::vector<interval> adjoint;
+
+	std::vector<char> reached;
+};
+
+}
+
+#endif // INTERVAL_AD_HPP_
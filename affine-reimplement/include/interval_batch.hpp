@@ -0,0 +1,113 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef INTERVAL_BATCH_HPP_
+#define INTERVAL_BATCH_HPP_
+
+#include <vector>
+#include "tape.hpp"
+
+namespace asol {
+
+class interval;
+class problem_data;
+
+// Structure-of-arrays counterpart of expression_graph<interval>: the node
+// enclosures of several boxes are stored lane by lane, and the forward and
+// backward sweeps process all boxes in lockstep. Infeasibility is recorded
+// per lane instead of throwing. Addition, subtraction, multiplication and
+// the intersections use AVX2 if available, the rest falls back to the
+// scalar interval functions lane by lane.
+class interval_batch {
+
+public:
+
+	interval_batch(const problem_data* problem, int lanes);
+
+	int lanes() const { return n_lanes; }
+
+	void set_box(int lane, const interval* box);
+
+	void disable(int lane);
+
+	bool feasible(int lane) const;
+
+	void get_box(int lane, interval* box) const;
+
+	void evaluate_all();
+
+	void revise_all();
+
+	// Sweeps until no lane makes sufficient progress on the variables
+	void iterative_revision();
+
+	int sweeps() const { return sweep_counter; }
+
+private:
+
+	interval_batch(const interval_batch& );
+	interval_batch& operator=(const interval_batch& );
+
+	double* lb(int node) { return &lo[node*stride]; }
+	double* ub(int node) { return &up[node*stride]; }
+
+	const interval get(int node, int lane) const;
+	void set(int node, int lane, const interval& x);
+
+	// These compute the result of the operation into tmp_lo, tmp_up
+	void sum(int x, int y);
+	void difference(int x, int y);
+	void product(int x, int y);
+
+	// Node z is intersected with tmp_lo, tmp_up
+	void intersect(int z);
+	void equals(int z, double rhs);
+
+	void scalar_evaluate(const tape_record& r);
+	void scalar_revise(const tape_record& r);
+
+	double sum_of_widths(int lane) const;
+	bool any_progress(const std::vector<double>& widths_before) const;
+
+	const std::vector<tape_record> tape;
+
+	const int n_vars;
+	const int n_nodes;
+	const int n_lanes;
+	const int stride; // n_lanes rounded up to the SIMD width
+
+	const std::vector<std::pair<int,double> > constants;
+
+	std::vector<double> lo;
+	std::vector<double> up;
+
+	std::vector<double> tmp_lo; // the result of the last operation
+	std::vector<double> tmp_up;
+
+	std::vector<char> alive;
+
+	int sweep_counter;
+};
+
+}
+
+#endif // INTERVAL_BATCH_HPP_
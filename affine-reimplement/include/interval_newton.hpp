@@ -0,0 +1,91 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef INTERVAL_NEWTON_HPP_
+#define INTERVAL_NEWTON_HPP_
+
+#include <vector>
+#include "interval.hpp"
+#include "interval_ad.hpp"
+
+namespace asol {
+
+class problem_data;
+
+enum newton_method {
+	NEWTON_GAUSS_SEIDEL,
+	NEWTON_KRAWCZYK
+};
+
+// Interval Newton step on square systems of equalities, preconditioned with
+// the inverse of the midpoint of the Jacobian; the mean value form is taken
+// at the midpoint of the box. Does nothing on other systems.
+class interval_newton {
+
+public:
+
+	explicit interval_newton(const problem_data* problem, newton_method method = NEWTON_GAUSS_SEIDEL);
+
+	bool applicable() const { return ad.square_system(); }
+
+	// Contracts the box in place, throws infeasible_problem if the box has no
+	// solution; returns true if a unique solution is proved in the box
+	bool contract(interval* box);
+
+	int proofs() const { return proof_count; }
+
+private:
+
+	// Y = inverse of the midpoint of J, false if it is singular
+	bool precondition();
+
+	// A = Y*J, b = Y*f(c)
+	void preconditioned_system();
+
+	bool gauss_seidel(interval* box) const;
+
+	bool krawczyk(interval* box) const;
+
+	interval_ad ad;
+
+	const newton_method method;
+
+	const int n;
+
+	interval_jacobian J;
+
+	std::vector<double> Y; // dense, row major
+
+	std::vector<double> c;
+
+	std::vector<interval> fc;
+
+	std::vector<interval> A; // dense, row major
+
+	std::vector<interval> b;
+
+	int proof_count;
+};
+
+}
+
+#endif // INTERVAL_NEWTON_HPP_
@@ -23,20 +23,38 @@
 #ifndef LP_IMPL_HPP_
 #define LP_IMPL_HPP_
 
+#include <stdint.h>
+#include <vector>
+
 namespace asol {
 
+struct sparse_rows;
+
 enum col_status {
 	BASIC,
 	NONBASIC_LB,
 	NONBASIC_UB
 };
 
+// Warm start information of a solved LP, the content depends on the backend
+struct lp_basis {
+
+	std::vector<int> status;
+
+	std::vector<double> point;
+};
+
 class lp_impl {
 
 public:
 
+	// Starts a new LP on the same columns; the rows of the previous LP are
+	// overwritten in place by add_eq_row() and the basis is kept
 	virtual void reset() = 0;
 
+	// Independent copy of the LP with its basis, to be solved on another thread
+	virtual lp_impl* clone() const = 0;
+
 	virtual void add_cols(int n) = 0;
 
 	// index[1] ... index[length]
@@ -64,12 +82,38 @@ public:
 
 	virtual double col_dual_val(int i) const = 0;
 
+	// Dual value of row i (1-based), same sign convention as col_dual_val()
+	virtual double row_dual_val(int i) const = 0;
+
+	// Row multipliers y proving that the last LP is infeasible, y[k] belongs
+	// to row k+1; false if the backend cannot provide them
+	virtual bool infeasibility_certificate(std::vector<double>& y) const = 0;
+
+	// Whether col_stat() and col_dual_val() are available after a solve
+	virtual bool has_reduced_costs() const = 0;
+
+	// How far col_val() may fall beyond a bound found by an earlier
+	// tighten_col_lb/ub() on the same LP, 0 if the solutions are exact
+	virtual double primal_tolerance() const = 0;
+
+	// The rows added since the last reset() if the backend keeps a copy of
+	// them, 0 otherwise
+	virtual const sparse_rows* recorded_rows() const = 0;
+
 	virtual bool is_fixed(int index) const = 0;
 
 	virtual void dump(const char* file) const = 0;
 
 	virtual void show_iteration_count() const = 0;
 
+	// Simplex iterations of all LPs solved so far
+	virtual uint64_t iteration_count() const = 0;
+
+	virtual void save_basis(lp_basis& basis) const = 0;
+
+	// Ignored if the basis does not fit the current LP
+	virtual void load_basis(const lp_basis& basis) = 0;
+
 	virtual ~lp_impl() = 0;
 
 protected:
@@ -24,6 +24,7 @@
 #define LP_PRUNING_HPP_
 
 #include <vector>
+#include "threads.hpp"
 
 namespace asol {
 
@@ -33,7 +34,8 @@ class lp_pruning {
 
 public:
 
-	lp_pruning(lp_impl* lp, const std::vector<int>& index_set);
+	// With threads > 1, the subproblems are solved on clones of lp
+	lp_pruning(lp_impl* lp, const std::vector<int>& index_set, int threads = 1);
 
 //	int index_to_split() const; // zero based index to be split, negative if none selected
 
@@ -41,6 +43,8 @@ public:
 
 	const std::vector<double>& new_ub_for_epsilon() const { return up; }
 
+	size_t tightened_by_reduced_costs() const { return tightened; }
+
 private:
 
 	lp_pruning(const lp_pruning& );
@@ -56,6 +60,27 @@ private:
 		bool operator<(const index_value& other) const { return value < other.value; }
 	};
 
+	// Distance of the last seen solution from the bound, a candidate is
+	// outdated if a newer one was pushed for the same position since
+	struct candidate {
+		double distance;
+		int    i;
+		int    stamp;
+		candidate(double d, int i, int s) : distance(d), i(i), stamp(s) { }
+		bool operator>(const candidate& other) const {
+			return distance > other.distance || (distance == other.distance && i > other.i);
+		}
+	};
+
+	typedef std::vector<candidate> candidate_heap; // closest on top
+
+	struct not_live {
+		const std::vector<int>& stamps;
+		const std::vector<char>& solved;
+		not_live(const std::vector<int>& st, const std::vector<char>& so) : stamps(st), solved(so) { }
+		bool operator()(const candidate& c) const { return solved.at(c.i)=='y' || stamps.at(c.i)!=c.stamp; }
+	};
+
 	void init_reverse_index_set();
 
 	void init_bounds();
@@ -66,15 +91,31 @@ private:
 
 	void examine_ub(int i, double val);
 
+	void push_candidate(candidate_heap& heap, std::vector<int>& stamps, const std::vector<char>& solved,
+	                    int i, double distance);
+
+	void closest(candidate_heap& heap, const std::vector<int>& stamps, const std::vector<char>& solved,
+	             int& index, double& distance);
+
 	void dbg_selection_results() const;
 
-	subproblem select_candidate();
+	subproblem select_candidate(const lp_impl* solver);
+
+	int claim(subproblem next);
+
+	void store_bound(subproblem solved, int i, double bound);
+
+	void tighten_by_reduced_costs(const lp_impl* solver, subproblem solved, int i);
+
+	void tighten_lb(int pos, double bound);
+
+	void tighten_ub(int pos, double bound);
 
 	void count_solved() const;
 
-	void solve_for_lb();
+	void prune_in_parallel();
 
-	void solve_for_ub();
+	friend class pruning_worker;
 
 	void save_reduced_costs(int index, std::vector<std::vector<double> >& d);
 
@@ -94,6 +135,12 @@ private:
 
 	lp_impl* const lp;
 
+	const int threads;
+
+	mutex state_lock; // guards the members below if threads > 1
+
+	bool aborted;
+
 	const std::vector<int>& index_set;
 
 	const size_t size;
@@ -106,11 +153,23 @@ private:
 	std::vector<double> lo;
 	std::vector<double> up;
 
+	std::vector<double> last_val; // the candidates are pushed only if it changes
+
+	candidate_heap min_heap;
+	candidate_heap max_heap;
+
+	std::vector<int> min_stamp;
+	std::vector<int> max_stamp;
+
 	std::vector<std::vector<double> > d_min;
 	std::vector<std::vector<double> > d_max;
 
 	size_t skipped;
 
+	size_t tightened; // bounds improved by the reduced costs
+
+	size_t solves; // by the workers, orders their last solutions
+
 	int index_min;
 	int index_max;
 
@@ -24,17 +24,24 @@
 #define LP_SOLVER_HPP_
 
 #include <vector>
+#include "farkas_cache.hpp"
+#include "lp_impl.hpp"
 
 namespace asol {
 
 class affine;
-class lp_impl;
+
+enum lp_backend {
+	LP_PORT,
+	LP_GLPK,
+	LP_DUAL_SIMPLEX
+};
 
 class lp_solver {
 
 public:
 
-	lp_solver();
+	explicit lp_solver(lp_backend backend = LP_PORT);
 
 	~lp_solver();
 
@@ -44,10 +51,21 @@ public:
 
 	void prune_upcoming_variables();
 
+	// Cached infeasibility certificates are tried first, see farkas_cache
 	void check_feasibility();
 
+	// The basis of the last LP, for warm_start() in the child boxes
+	void save_basis(lp_basis& basis) const;
+
+	// Applied at the next check_feasibility()
+	void warm_start(const lp_basis& basis);
+
 	void set_number_of_vars(int n);
 
+	// Threads solving the bounding LPs in prune(), 1 by default; more only
+	// with LP_DUAL_SIMPLEX, PORT is serialized and GLPK is not thread-safe
+	void set_pruning_threads(int n);
+
 	void set_affine_vars(std::vector<affine>* v);
 
 	void set_pruning_indices(const std::vector<std::vector<int> >& indices_to_prune_after_constraint);
@@ -57,6 +75,14 @@ public:
 
 	void show_iteration_count() const;
 
+	// Those of the clones solving the bounding LPs on other threads excluded
+	uint64_t iteration_count() const;
+
+	// Records every LP built and solved from now on into file, see lp_trace
+	void capture_trace(const char* file);
+
+	static lp_impl* new_lp_impl(lp_backend backend);
+
 	static void free_environment();
 
 private:
@@ -89,15 +115,25 @@ private:
 
 	int  col_size() const;
 
+	void save_certificate();
+
+	const lp_backend backend;
 	lp_impl* lp;
 	int N_VARS;
 	const double TINY;
+	int pruning_threads;
 	std::vector<std::vector<int> > pruning_indices;
 
 	std::vector<affine>* v;
 
 	std::vector<int>    col_index;
 	std::vector<double> col_coeff;
+
+	lp_basis initial_basis;
+
+	bool has_initial_basis;
+
+	farkas_cache certificates;
 };
 
 }
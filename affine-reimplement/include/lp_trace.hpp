@@ -0,0 +1,182 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef LP_TRACE_HPP_
+#define LP_TRACE_HPP_
+
+#include <fstream>
+#include <vector>
+#include "lp_impl.hpp"
+
+namespace asol {
+
+// Binary trace of the LPs of a search, in native byte order: the rows, the
+// bounds and each solve with its outcome, see lp_trace_recorder. The basis
+// loaded for warm starts is not recorded as its format depends on the
+// backend.
+enum trace_event {
+	TRACE_RESET,
+	TRACE_ADD_COLS,
+	TRACE_ADD_ROW,
+	TRACE_COL_BOUNDS,
+	TRACE_RUN_SIMPLEX,
+	TRACE_TIGHTEN_LB,
+	TRACE_TIGHTEN_UB
+};
+
+enum trace_outcome {
+	TRACE_SOLVED,
+	TRACE_INFEASIBLE,
+	TRACE_NUMERICAL_PROBLEMS
+};
+
+struct trace_record {
+
+	trace_record();
+
+	// Solved by default, the outcome and the result are set after the call
+	trace_record(int event, int index, double lb = 0.0, double ub = 0.0);
+
+	int event;
+	int index;   // column, number of columns or row length
+	int outcome;
+	double lb;   // old bound of tighten_col_lb/ub()
+	double ub;
+	double result;
+	std::vector<int>    cols;   // cols[1] ... cols[index]
+	std::vector<double> coeffs;
+};
+
+// Writes every call that changes or solves the LP to a trace file, then
+// forwards it to the wrapped backend. The clones are not recorded: capture
+// with a single pruning thread.
+class lp_trace_recorder : public lp_impl {
+
+public:
+
+	// Takes the ownership of solver
+	lp_trace_recorder(lp_impl* solver, const char* file);
+
+private:
+
+	virtual ~lp_trace_recorder();
+
+	virtual void reset();
+
+	virtual lp_impl* clone() const;
+
+	virtual void add_cols(int n);
+
+	// index[1] ... index[length]
+	virtual void add_eq_row(const int index[], const double value[], int length, double lb, double ub);
+
+	virtual void set_col_bounds(int index, double lb, double ub);
+
+	virtual void run_simplex();
+
+	virtual double tighten_col_lb(int i, const double lb);
+
+	virtual double tighten_col_ub(int i, const double ub);
+
+	virtual int num_cols() const;
+
+	virtual int num_rows() const;
+
+	virtual col_status col_stat(int i) const;
+
+	virtual double col_val(int i) const;
+
+	virtual double col_lb(int i) const;
+
+	virtual double col_ub(int i) const;
+
+	virtual double col_dual_val(int i) const;
+
+	virtual double row_dual_val(int i) const;
+
+	virtual bool infeasibility_certificate(std::vector<double>& y) const;
+
+	virtual bool has_reduced_costs() const;
+
+	virtual double primal_tolerance() const;
+
+	virtual const sparse_rows* recorded_rows() const;
+
+	virtual bool is_fixed(int index) const;
+
+	virtual void dump(const char* file) const;
+
+	virtual void show_iteration_count() const;
+
+	virtual uint64_t iteration_count() const;
+
+	virtual void save_basis(lp_basis& basis) const;
+
+	virtual void load_basis(const lp_basis& basis);
+
+	//===================================
+
+	lp_trace_recorder(const lp_trace_recorder& );
+
+	lp_trace_recorder& operator=(const lp_trace_recorder& );
+
+	double tighten(int event, int i, double bound);
+
+	void write(const trace_record& rec);
+
+	//===================================
+
+	lp_impl* const lp;
+
+	std::ofstream out;
+};
+
+// Reads a whole trace, then replays it against any backend
+class lp_trace_replay {
+
+public:
+
+	explicit lp_trace_replay(const char* file);
+
+	struct statistics {
+		int solves;
+		int outcome_mismatches;
+		int bound_discrepancies; // beyond TOL_DISCREPANCY
+		double max_discrepancy;
+		double seconds;
+	};
+
+	// The recorded LPs are rebuilt and solved on lp
+	const statistics run(lp_impl* lp) const;
+
+	int size() const { return static_cast<int>(trace.size()); }
+
+private:
+
+	void replay(lp_impl* lp, const trace_record& rec, statistics& stats) const;
+
+	std::vector<trace_record> trace;
+};
+
+}
+
+#endif // LP_TRACE_HPP_
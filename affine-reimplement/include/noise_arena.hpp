@@ -0,0 +1,149 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef NOISE_ARENA_HPP_
+#define NOISE_ARENA_HPP_
+
+#include <vector>
+
+namespace asol {
+
+struct epsilon {
+
+	epsilon() : index(-1), coeff(1.0e+300) { }
+
+	epsilon(int i, double c) : index(i), coeff(c) { }
+
+	int    index;
+
+	double coeff;
+};
+
+// Bump allocator for the noise terms; nothing is freed individually. The
+// blocks allocated before set_mark() survive rewind(), everything else is
+// handed out again after it.
+class noise_arena {
+
+public:
+
+	noise_arena();
+
+	epsilon* allocate(int n);
+
+	void set_mark();
+
+	void rewind();
+
+	int generation() const { return gen; }
+
+	~noise_arena();
+
+private:
+
+	noise_arena(const noise_arena& );
+	noise_arena& operator=(const noise_arena& );
+
+	std::vector<epsilon*> chunks;
+	std::vector<int> chunk_size;
+
+	int chunk;
+	int top;
+
+	int mark_chunk;
+	int mark_top;
+
+	int gen;
+};
+
+// The noise terms of an affine form, stored in the arena of the current
+// solver_context, or in a caller supplied buffer first for temporaries.
+// The storage is dropped on clear() if the arena has been rewound since.
+class noise_terms {
+
+public:
+
+	noise_terms() : data(0), length(0), capacity(0), generation(STALE) { }
+
+	noise_terms(epsilon* buffer, int size) : data(buffer), length(0), capacity(size), generation(INLINE) { }
+
+	noise_terms(const noise_terms& other);
+
+	noise_terms& operator=(const noise_terms& other);
+
+	int size() const { return length; }
+
+	bool empty() const { return length==0; }
+
+	const epsilon* begin() const { return data; }
+
+	const epsilon* end() const { return data+length; }
+
+	epsilon& at(int i) { check_index(i); return data[i]; }
+
+	const epsilon& at(int i) const { check_index(i); return data[i]; }
+
+	epsilon& back() { return at(length-1); }
+
+	const epsilon& back() const { return at(length-1); }
+
+	void pop_back() { check_index(length-1); --length; }
+
+	void push_back(const epsilon& e) {
+
+		if (length==capacity) {
+
+			grow(length+1);
+		}
+
+		data[length++] = e;
+	}
+
+	void clear();
+
+	void reserve(int n);
+
+private:
+
+	enum { STALE = -1, INLINE = -2 };
+
+	bool owns_storage() const;
+
+	void grow(int n);
+
+#ifdef ASOL_ENABLE_ASSERTS
+	void check_index(int i) const;
+#else
+	void check_index(int ) const { }
+#endif
+
+	epsilon* data;
+
+	int length;
+
+	int capacity;
+
+	int generation;
+};
+
+}
+
+#endif // NOISE_ARENA_HPP_
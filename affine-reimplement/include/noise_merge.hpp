@@ -0,0 +1,91 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef NOISE_MERGE_HPP_
+#define NOISE_MERGE_HPP_
+
+#include "affine.hpp"
+
+namespace asol {
+
+// Walks the union of the noise symbols of x and y in increasing order and
+// calls op.init_z0(x_0, y_0), then op.set_zi(index, x_i, y_i) for each
+// symbol, with 0.0 for a symbol missing from one of the forms. Shared
+// symbols are tested first; once either form runs out, the rest of the
+// other is passed on without comparing indices.
+template <typename Op>
+void merge_noise_terms(const affine& x, const affine& y, Op& op) {
+
+	x.dbg_consistency();
+	y.dbg_consistency();
+
+	const epsilon*       i     = x.noise_vars.begin();
+	const epsilon* const i_end = x.noise_vars.end();
+	const epsilon*       j     = y.noise_vars.begin();
+	const epsilon* const j_end = y.noise_vars.end();
+
+	op.init_z0(i->coeff, j->coeff);
+
+	++i;
+	++j;
+
+	while (i != i_end && j != j_end) {
+
+		const int i_index = i->index;
+
+		const int j_index = j->index;
+
+		if (i_index == j_index) {
+
+			op.set_zi(i_index, i->coeff, j->coeff);
+
+			++i;
+			++j;
+		}
+		else if (i_index < j_index) {
+
+			op.set_zi(i_index, i->coeff, 0.0);
+
+			++i;
+		}
+		else {
+
+			op.set_zi(j_index, 0.0, j->coeff);
+
+			++j;
+		}
+	}
+
+	for ( ; i != i_end; ++i) {
+
+		op.set_zi(i->index, i->coeff, 0.0);
+	}
+
+	for ( ; j != j_end; ++j) {
+
+		op.set_zi(j->index, 0.0, j->coeff);
+	}
+}
+
+}
+
+#endif // NOISE_MERGE_HPP_
@@ -0,0 +1,77 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef PARALLEL_SEARCH_HPP_
+#define PARALLEL_SEARCH_HPP_
+
+#include <vector>
+#include "search_procedure.hpp"
+
+namespace asol {
+
+template <typename> class problem;
+class box_scheduler;
+class builder;
+
+// Runs the branch-and-prune search on several threads. Each thread has its
+// own search_procedure, the boxes are shared through work-stealing deques.
+// The calls into PORT are serialized, the LP stage of the workers only runs
+// concurrently with the other backends.
+class parallel_search {
+
+public:
+
+	parallel_search(const problem<builder>* problem_to_solve, int number_of_threads, lp_backend backend = LP_PORT);
+
+	void run();
+
+	const search_procedure::statistics& get_statistics() const { return total; }
+
+	int steals() const;
+
+	~parallel_search();
+
+private:
+
+	parallel_search(const parallel_search& );
+	parallel_search& operator=(const parallel_search& );
+
+	void push_initial_box(const problem_data* representation);
+
+	void merge_statistics();
+
+	void print_statistics() const;
+
+	solver_context context;
+
+	const int n_threads;
+
+	box_scheduler* scheduler;
+
+	std::vector<search_procedure*> workers;
+
+	search_procedure::statistics total;
+};
+
+}
+
+#endif // PARALLEL_SEARCH_HPP_
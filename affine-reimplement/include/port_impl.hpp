@@ -41,6 +41,8 @@ private:
 
 	virtual void reset();
 
+	virtual lp_impl* clone() const;
+
 	virtual void add_cols(int n);
 
 	// index[1] ... index[length]
@@ -68,15 +70,31 @@ private:
 
 	virtual double col_dual_val(int i) const;
 
+	virtual double row_dual_val(int i) const;
+
+	virtual bool infeasibility_certificate(std::vector<double>& y) const;
+
+	virtual bool has_reduced_costs() const;
+
+	virtual double primal_tolerance() const;
+
+	virtual const sparse_rows* recorded_rows() const;
+
 	virtual bool is_fixed(int index) const;
 
 	virtual void dump(const char* file) const;
 
 	virtual void show_iteration_count() const;
 
+	virtual uint64_t iteration_count() const;
+
+	virtual void save_basis(lp_basis& basis) const;
+
+	virtual void load_basis(const lp_basis& basis);
+
 	//===================================
 
-	port_impl(const port_impl& );
+	port_impl(const port_impl& other);
 
 	port_impl& operator=(const port_impl& );
 
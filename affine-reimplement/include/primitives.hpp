@@ -24,6 +24,7 @@
 #define PRIMITIVES_HPP_
 
 #include <vector>
+#include "solver_context.hpp"
 
 namespace asol {
 
@@ -54,15 +55,14 @@ protected:
 
 	explicit primitive(int lhs);
 
-	T& val() const { return v->at(z); }
+	T& val() const { return nodes()->at(z); }
 
 	void push_back(int index, const T& value) const;
 
 	const int z;
 
-	static std::vector<T>* v;
-
-	static std::vector<gap_info<T> >* gaps;
+	// The node vector of the current solver_context
+	static std::vector<T>* nodes() { return solver_context::current().nodes<T>().v; }
 };
 
 template <typename T>
@@ -76,7 +76,7 @@ protected:
 
 	virtual const unary_primitive<T>* downcast(const primitive<T>* other) const = 0;
 
-	T& arg() const { return primitive<T>::v->at(x); }
+	T& arg() const { return primitive<T>::nodes()->at(x); }
 
 	const int x;
 };
@@ -92,9 +92,9 @@ protected:
 
 	virtual const binary_primitive<T>* downcast(const primitive<T>* other) const = 0;
 
-	T& arg1() const { return primitive<T>::v->at(x); }
+	T& arg1() const { return primitive<T>::nodes()->at(x); }
 
-	T& arg2() const { return primitive<T>::v->at(y); }
+	T& arg2() const { return primitive<T>::nodes()->at(y); }
 
 	const int x;
 
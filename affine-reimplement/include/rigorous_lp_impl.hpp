@@ -0,0 +1,126 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef RIGOROUS_LP_IMPL_HPP_
+#define RIGOROUS_LP_IMPL_HPP_
+
+#include <vector>
+#include "lp_impl.hpp"
+#include "sparse_rows.hpp"
+
+namespace asol {
+
+// Wraps another backend and replaces the floating-point optimum of each
+// tighten_col_lb/ub() with a verified bound, following Neumaier and
+// Shcherbina, Math. Programming A 99 (2004), 283-296. For any row duals
+// y, x_i = (e_i - A^T y)^T x + y^T A x holds, and with directed rounding
+// both terms can be bounded safely over the column and row bounds; the
+// approximate duals of the backend make the bound nearly optimal. The rows
+// are recorded as they pass through, lp_solver reads them through
+// recorded_rows() for its Farkas cache. The reduced costs are verified in the
+// same way, see col_dual_val(). See also rounding_mode.
+class rigorous_lp_impl : public lp_impl {
+
+public:
+
+	// Takes the ownership of solver
+	explicit rigorous_lp_impl(lp_impl* solver);
+
+private:
+
+	virtual ~rigorous_lp_impl();
+
+	virtual void reset();
+
+	virtual lp_impl* clone() const;
+
+	virtual void add_cols(int n);
+
+	// index[1] ... index[length]
+	virtual void add_eq_row(const int index[], const double value[], int length, double lb, double ub);
+
+	virtual void set_col_bounds(int index, double lb, double ub);
+
+	virtual void run_simplex();
+
+	virtual double tighten_col_lb(int i, const double lb);
+
+	virtual double tighten_col_ub(int i, const double ub);
+
+	virtual int num_cols() const;
+
+	virtual int num_rows() const;
+
+	virtual col_status col_stat(int i) const;
+
+	virtual double col_val(int i) const;
+
+	virtual double col_lb(int i) const;
+
+	virtual double col_ub(int i) const;
+
+	virtual double col_dual_val(int i) const;
+
+	virtual double row_dual_val(int i) const;
+
+	virtual bool infeasibility_certificate(std::vector<double>& y) const;
+
+	virtual bool has_reduced_costs() const;
+
+	virtual double primal_tolerance() const;
+
+	virtual const sparse_rows* recorded_rows() const;
+
+	virtual bool is_fixed(int index) const;
+
+	virtual void dump(const char* file) const;
+
+	virtual void show_iteration_count() const;
+
+	virtual uint64_t iteration_count() const;
+
+	virtual void save_basis(lp_basis& basis) const;
+
+	virtual void load_basis(const lp_basis& basis);
+
+	//===================================
+
+	rigorous_lp_impl(const rigorous_lp_impl& );
+
+	rigorous_lp_impl& operator=(const rigorous_lp_impl& );
+
+	double safe_lower_bound(int i, double sign);
+
+	void forget_reduced_costs();
+
+	//===================================
+
+	lp_impl* const lp;
+
+	sparse_rows rows;
+
+	std::vector<double> reduced_costs; // of the last tightened bound, 1-based
+};
+
+}
+
+#endif // RIGOROUS_LP_IMPL_HPP_
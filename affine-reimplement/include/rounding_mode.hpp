@@ -20,39 +20,32 @@
 //
 //==============================================================================
 
-#ifndef AFFINE_PAIR_ITERATOR_HPP_
-#define AFFINE_PAIR_ITERATOR_HPP_
-
-#include "affine.hpp"
+#ifndef ROUNDING_MODE_HPP_
+#define ROUNDING_MODE_HPP_
 
 namespace asol {
 
-class affine_pair_iterator {
+// Sets the floating-point rounding mode, round to nearest is restored on
+// leaving the scope, exceptions included. The compiler must honor it, e.g.
+// -frounding-math with gcc.
+class rounding_mode {
 
 public:
 
-	affine_pair_iterator(const affine& x, const affine& y);
-
-	bool increment();
+	enum direction { DOWNWARD, UPWARD };
 
-	int  index() const { return k; }
-	double x_i() const { return x_k; }
-	double y_i() const { return y_k; }
+	explicit rounding_mode(direction dir);
 
-private:
+	void set(direction dir);
 
-	typedef std::vector<epsilon>::const_iterator itr;
+	~rounding_mode();
 
-	itr i;
-	itr i_end;
-	itr j;
-	itr j_end;
+private:
 
-	int k;
-	double x_k;
-	double y_k;
+	rounding_mode(const rounding_mode& );
+	rounding_mode& operator=(const rounding_mode& );
 };
 
 }
 
-#endif // AFFINE_PAIR_ITERATOR_HPP_
+#endif // ROUNDING_MODE_HPP_
@@ -23,46 +23,137 @@
 #ifndef SEARCH_PROCEDURE_HPP_
 #define SEARCH_PROCEDURE_HPP_
 
+#include <stdint.h>
 #include <deque>
+#include <map>
+#include <string>
 #include <vector>
+#include "box_queue.hpp"
+#include "contractor_scheduler.hpp"
+#include "expression_graph.hpp"
+#include "frontier_spill.hpp"
+#include "interval.hpp"
+#include "lp_impl.hpp"
+#include "lp_solver.hpp"
+#include "solver_context.hpp"
+#include "typedefs.hpp"
 
 namespace asol {
 
-template <typename> class expression_graph;
 template <typename> class problem;
 class affine;
+class box_pool;
+class box_scheduler;
 class builder;
 class splitting_strategy;
-class interval;
-class lp_solver;
+class split_tree;
+class interval_ad;
+class interval_batch;
+class interval_newton;
 class problem_data;
+struct split_node;
 
-class search_procedure {
+class search_procedure : private spill_observer {
 
 public:
 
-	search_procedure(const problem<builder>* problem_to_solve);
+	explicit search_procedure(const problem<builder>* problem_to_solve, lp_backend backend = LP_PORT);
+
+	// Worker of parallel_search, the boxes come from and go to the scheduler
+	search_procedure(const problem_data* problem,
+	                 const DoubleArray2D& solutions,
+	                 box_scheduler* scheduler,
+	                 int worker_id,
+	                 lp_backend backend = LP_PORT);
 
 	void run();
 
-	~search_procedure();
+	void run_worker();
+
+	// The LPs of run() are written to file, see lp_trace_replay
+	void capture_lp_trace(const char* file);
+
+	// Decides when the LP stage of contracting_step() runs
+	void set_scheduling(const scheduling_options& options);
+
+	// Threads of the LP pruning, see lp_solver::set_pruning_threads()
+	void set_pruning_threads(int n);
+
+	// Off by default: the children of a split box start from the contracted
+	// node enclosures of the parent instead of ANY_REAL(). Each pending box
+	// then stores the enclosures of the parent's dag, O(nodes) per box.
+	void set_node_inheritance(bool on);
+
+	// On by default: the LPs of the children of a split box start from the
+	// basis of the parent's last LP; serial search only
+	void set_warm_start(bool on);
+
+	// Replaces the initial box of the problem, must be called before run()
+	void set_initial_box(const std::vector<interval>& box);
+
+	// A box converges if all its variables are narrower than tol
+	void set_convergence_tolerance(double tol);
+
+	// Breadth-first by default, must be called before run() and resume()
+	void set_search_order(const search_options& options);
+
+	// The state of run() is written to file every period seconds, see
+	// checkpoint_writer; serial search only
+	void set_checkpoint(const char* file, double period);
+
+	// The pending boxes and the counters are replaced by those of the
+	// checkpoint, written by a search on the same problem; call run() next
+	void resume(const char* file);
+
+	struct statistics {
+		int solutions_found;
+		int splits;
+		int boxes_processed;
+		int peak_frontier;
+		int splits_to_first_solution; // -1 if no solution is found
+		int solutions_proved; // by interval Newton, included in solutions_found
+		uint64_t simplex_iterations; // see lp_solver::iteration_count()
+	};
+
+	const statistics get_statistics() const;
+
+	// How many times each known solution was found by this search
+	const std::vector<int>& found_solution_counters() const;
+
+	void print_found_solutions() const;
+
+	virtual ~search_procedure();
 
 private:
 
 	search_procedure(const search_procedure& );
 	search_procedure& operator=(const search_procedure& );
 
+	typedef const void* box_key; // the slab of a pending box, or its split_tree node
+
 	void build_problem_representation();
-	void init_dags();
+	void init_dags(const DoubleArray2D& solutions);
 	void init_lp_solver();
 	void evaluate_with_builder() const;
 	void push_initial_box_to_deque();
 	std::vector<std::vector<int> > index_sets() const;
 
 	bool has_more_boxes() const;
+	int pending_size() const;
+	int peak_frontier() const;
+	interval* pop_pending_box(const split_node*& node);
+	void release_nodes();
+	bool needs_screening() const;
+	void screen_pending_boxes();
 	void get_next_box();
 	void process_box();
 	void split_if_not_discarded();
+	void push_box(interval* box, const split_node* node = 0);
+	bool checkpoint_due() const;
+	void save_checkpoint();
+	virtual int box_spilled(const interval* box);
+	virtual void box_restored(const interval* box, int tag);
+	double priority(const interval* box);
 	void print_statistics() const;
 
 	void roll_back();
@@ -72,16 +163,31 @@ private:
 	bool sufficient(const double max_progress) const;
 	double compute_max_progress() const;
 	void split();
+	void save_warm_start(box_key box);
+	void load_warm_start(box_key box);
+	void save_depth(box_key box);
+	void load_depth(box_key box);
+	void save_enclosures(box_key box);
+	void load_enclosures(box_key box);
 
 	void delete_box();
 	void print_box() const;
 	void contracting_step();
+	void run_stage(contractor c, void (search_procedure::*stage)());
+	void ia_stage();
+	void newton_stage();
+	void lp_stage();
+	double reduction(const interval* box_before) const;
 	void check_convergence();
+	void check_uniqueness_proof();
+	void save_solution();
 
 	void dbg_check_infeasibilty() const;
 	void dbg_solution_count();
 	void dbg_initial_box_from_dump();
 
+	solver_context context;
+
 	const problem<builder>* prob;
 
 	const splitting_strategy* split_strategy;
@@ -94,17 +200,77 @@ private:
 
 	expression_graph<affine>* aa_dag;
 
+	interval_batch* ia_batch;
+
+	interval_newton* newton;
+
+	interval_ad* residual_ad; // of the SMALLEST_RESIDUAL heuristic
+
 	lp_solver* lp;
 
-	std::deque<interval*> pending_boxes;
+	search_options order;
+
+	box_queue<interval>* pending_boxes;
+
+	box_queue<const split_node>* pending_nodes; // instead of pending_boxes if the frontier is compact
+
+	split_tree* tree; // of the compact frontier, 0 otherwise
+
+	std::deque<interval*> screened_boxes; // popped from the queue and contracted together
+
+	std::deque<const split_node*> screened_nodes; // of the screened boxes, 0 if not compact
+
+	std::vector<interval> residuals;
+
+	box_scheduler* const scheduler;
+
+	box_pool* const pool; // owned if there is no scheduler
+
+	const int worker_id;
+
+	std::map<box_key, lp_basis> warm_starts; // of the pending boxes, serial search only
+
+	std::map<box_key, int> depths; // of the pending boxes, serial search only
+
+	std::map<box_key, node_enclosures<interval> > enclosures; // of the pending boxes, serial search only
+
+	node_enclosures<interval> inherited; // by box_orig, used in its first contracting step
+
+	bool has_inherited;
+
+	bool inherit_enclosures;
+
+	bool warm_start_lp;
+
+	contractor_scheduler* schedule;
+
+	int depth; // of box_orig
+
+	bool unique_solution_proved; // in box_orig by newton_stage
 
 	interval* box_orig;
 
+	const split_node* node_orig; // of box_orig if the frontier is compact
+
 	int solutions_found;
 
 	int splits;
 
 	int boxes_processed;
+
+	int splits_to_first_solution;
+
+	int solutions_proved; // boxes ended by check_uniqueness_proof()
+
+	double convergence_tol;
+
+	std::vector<interval> solution_boxes; // n_vars each
+
+	std::string checkpoint_file;
+
+	double checkpoint_period;
+
+	double last_checkpoint;
 };
 
 }
@@ -54,6 +54,10 @@ public:
 
 	void print_found_solutions() const;
 
+	// The counters are in the current solver_context, kept when a new
+	// tracker is created for the next box
+	static void print_counters(const std::vector<int>& found);
+
 	~sol_tracker();
 
 private:
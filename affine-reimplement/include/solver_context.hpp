@@ -0,0 +1,130 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef SOLVER_CONTEXT_HPP_
+#define SOLVER_CONTEXT_HPP_
+
+#include <vector>
+#include "noise_arena.hpp"
+#include "thread_local.hpp"
+
+namespace asol {
+
+class affine;
+class builder;
+class interval;
+class lp_solver;
+class problem_data;
+template <typename T> struct gap_info;
+
+template <typename T>
+struct node_state {
+
+	node_state() : v(0), gaps(0) { }
+
+	std::vector<T>* v;
+
+	std::vector<gap_info<T> >* gaps;
+};
+
+// The state that the builder, the primitives and the affine arithmetic
+// share while one problem is recorded or solved. Each solver owns one and
+// makes it current on its thread with a context_scope; without a scope
+// the thread works on the process-wide default context.
+class solver_context {
+
+public:
+
+	solver_context();
+
+	~solver_context();
+
+	static solver_context& current() { return active ? *active : default_context(); }
+
+	template <typename T>
+	node_state<T>& nodes();
+
+	// Recording target of the builder
+	problem_data* problem;
+
+	// The affine arithmetic
+	std::vector<interval>* affine_ranges;
+
+	lp_solver* lp;
+
+	int max_used_index;
+
+	int last_variable_index;
+
+	int noise_term_limit;
+
+	std::vector<double> magnitudes;
+
+	bool excellent_progress_made;
+
+	// How many times each known solution was found, see sol_tracker
+	std::vector<int> found_solutions;
+
+	noise_arena noise;
+
+private:
+
+	solver_context(const solver_context& );
+	solver_context& operator=(const solver_context& );
+
+	friend class context_scope;
+
+	static solver_context& default_context();
+
+	static ASOL_THREAD_LOCAL solver_context* active;
+
+	node_state<interval> interval_nodes;
+
+	node_state<affine>   affine_nodes;
+
+	node_state<builder>  builder_nodes;
+};
+
+template <> node_state<interval>& solver_context::nodes<interval>();
+template <> node_state<affine>&   solver_context::nodes<affine>();
+template <> node_state<builder>&  solver_context::nodes<builder>();
+
+// Makes the context current on the calling thread until the end of scope
+class context_scope {
+
+public:
+
+	explicit context_scope(solver_context& context);
+
+	~context_scope();
+
+private:
+
+	context_scope(const context_scope& );
+	context_scope& operator=(const context_scope& );
+
+	solver_context* const previous;
+};
+
+}
+
+#endif // SOLVER_CONTEXT_HPP_
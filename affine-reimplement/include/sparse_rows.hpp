@@ -0,0 +1,75 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef SPARSE_ROWS_HPP_
+#define SPARSE_ROWS_HPP_
+
+#include <vector>
+
+namespace asol {
+
+// Copy of the rows passed to lp_impl::add_eq_row(), row k is made of the
+// entries [start[k], start[k+1]) with 1-based column indices
+struct sparse_rows {
+
+	sparse_rows() : start(1, 0) { }
+
+	// index[1] ... index[length]
+	void add(const int col_index[], const double value[], int length, double row_lb, double row_ub) {
+
+		index.insert(index.end(), col_index+1, col_index+length+1);
+
+		coeff.insert(coeff.end(), value+1, value+length+1);
+
+		start.push_back(static_cast<int>(index.size()));
+
+		lb.push_back(row_lb);
+
+		ub.push_back(row_ub);
+	}
+
+	void clear() {
+
+		start.assign(1, 0);
+
+		index.clear();
+
+		coeff.clear();
+
+		lb.clear();
+
+		ub.clear();
+	}
+
+	int size() const { return static_cast<int>(lb.size()); }
+
+	std::vector<int>    start;
+	std::vector<int>    index;
+	std::vector<double> coeff;
+
+	std::vector<double> lb;
+	std::vector<double> ub;
+};
+
+}
+
+#endif // SPARSE_ROWS_HPP_
@@ -0,0 +1,90 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef SPLIT_TREE_HPP_
+#define SPLIT_TREE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace asol {
+
+class interval;
+
+struct split_node;
+
+// Compact storage of the pending boxes: a node only holds the components
+// in which its box differs from the box of its parent. A root holds the
+// full box; a box that differs from its parent in too many components
+// becomes a new root. The child of a split is a single component. The nodes are
+// reference counted; a node is freed together with its last reference,
+// and then releases its parent. The owner must release all nodes.
+class split_tree {
+
+public:
+
+	explicit split_tree(int n_vars);
+
+	const split_node* add_root(const interval* box);
+
+	// Diffs box against the box of parent
+	const split_node* add(const split_node* parent, const interval* box);
+
+	const split_node* add(const split_node* parent, int index, const interval& bounds);
+
+	void materialize(const split_node* node, interval* box);
+
+	void release(const split_node* node);
+
+	int nodes() const { return n_nodes; }
+
+	std::size_t memory() const { return bytes; }
+
+	std::size_t peak_memory() const { return peak_bytes; }
+
+private:
+
+	split_tree(const split_tree& );
+	split_tree& operator=(const split_tree& );
+
+	std::size_t size(const split_node* parent, int n_changes) const;
+
+	split_node* new_node(const split_node* parent, int n_changes);
+
+	void count(std::ptrdiff_t delta);
+
+	const int n_vars;
+
+	std::vector<const split_node*> path;
+
+	std::vector<interval> scratch;
+
+	int n_nodes;
+
+	std::size_t bytes;
+
+	std::size_t peak_bytes;
+};
+
+}
+
+#endif // SPLIT_TREE_HPP_
@@ -0,0 +1,76 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef TAPE_HPP_
+#define TAPE_HPP_
+
+#include <vector>
+
+namespace asol {
+
+template <typename T> struct gap_info;
+
+enum opcode {
+	OP_ADD,
+	OP_SUB,
+	OP_MUL,
+	OP_DIV,
+	OP_SQR,
+	OP_EXP,
+	OP_LOG,
+	OP_EQUALITY,
+	OP_CSE,
+	OP_LESS_EQ
+};
+
+// Flat, POD counterpart of the primitives; unused fields are -1 and 0.0
+struct tape_record {
+	int op;
+	int z;
+	int x;
+	int y;
+	double rhs;
+};
+
+template <typename T>
+class tape_interpreter {
+
+public:
+
+	explicit tape_interpreter(const std::vector<tape_record>& code) : tape(code) { }
+
+	int size() const { return static_cast<int>(tape.size()); }
+
+	// Forward sweep on tape[first] ... tape[last]
+	void evaluate(T* v, int first, int last) const;
+
+	// Backward sweep on tape[last] ... tape[first], gaps are saved if not NULL
+	void revise(T* v, int first, int last, std::vector<gap_info<T> >* gaps) const;
+
+private:
+
+	const std::vector<tape_record> tape;
+};
+
+}
+
+#endif // TAPE_HPP_
@@ -0,0 +1,108 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifndef THREADS_HPP_
+#define THREADS_HPP_
+
+#include <pthread.h>
+#include <vector>
+
+namespace asol {
+
+class mutex {
+
+public:
+
+	mutex();
+
+	void lock();
+
+	void unlock();
+
+	~mutex();
+
+private:
+
+	mutex(const mutex& );
+	mutex& operator=(const mutex& );
+
+	friend class condition;
+
+	pthread_mutex_t m;
+};
+
+class scoped_lock {
+
+public:
+
+	explicit scoped_lock(mutex& m) : m(m) { m.lock(); }
+
+	~scoped_lock() { m.unlock(); }
+
+private:
+
+	scoped_lock(const scoped_lock& );
+	scoped_lock& operator=(const scoped_lock& );
+
+	mutex& m;
+};
+
+class condition {
+
+public:
+
+	condition();
+
+	// The mutex must be locked by the caller
+	void wait(mutex& m);
+
+	void signal();
+
+	void broadcast();
+
+	~condition();
+
+private:
+
+	condition(const condition& );
+	condition& operator=(const condition& );
+
+	pthread_cond_t c;
+};
+
+class runnable {
+
+public:
+
+	virtual void run() = 0;
+
+	virtual ~runnable() { }
+};
+
+// Runs each task on its own thread and waits for all of them
+void run_in_parallel(const std::vector<runnable*>& tasks);
+
+int number_of_cores();
+
+}
+
+#endif // THREADS_HPP_
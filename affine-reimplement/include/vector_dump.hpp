@@ -34,6 +34,12 @@ void dump(const std::vector<interval>& v, const char* filename = DUMP_FILE_NAME)
 
 void load(std::vector<interval>& v);
 
+// Binary records of boxes: the lower and upper bound of each component,
+// 2*n doubles in total
+void pack(const interval* box, int n, double* record);
+
+void unpack(const double* record, int n, interval* box);
+
 }
 
 #endif // VECTOR_DUMP_HPP_
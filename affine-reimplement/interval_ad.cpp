@@ -0,0 +1,357 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <cmath>
+#include "interval_ad.hpp"
+#include "diagnostics.hpp"
+#include "problem_data.hpp"
+
+using namespace std;
+
+namespace {
+
+// Same as the bounds of interval::ANY_REAL()
+bool finite(const asol::interval& x) {
+
+	const double LIMIT = 1.0e+150;
+
+	return std::fabs(x.unchecked_inf()) <= LIMIT && std::fabs(x.unchecked_sup()) <= LIMIT;
+}
+
+}
+
+namespace asol {
+
+extern const std::vector<tape_record> convert_to_tape(const std::vector<primitive<builder>*>& v);
+
+interval_ad::interval_ad(const problem_data* problem) :
+
+	tape     (convert_to_tape(problem->get_primitives())),
+	n_vars   (problem->number_of_variables()),
+	n_nodes  (problem->peek_index()),
+	constants(problem->get_numeric_constants().begin(), problem->get_numeric_constants().end()),
+	equalities_only(true),
+	v        (n_nodes, interval::ANY_REAL()),
+	grad     (n_nodes),
+	adjoint  (n_nodes),
+	reached  (n_nodes, 0)
+{
+	for (int i=0; i<static_cast<int>(tape.size()); ++i) {
+
+		const tape_record& r = tape.at(i);
+
+		if (r.op == OP_EQUALITY) {
+
+			body.push_back(r.z);
+
+			rhs.push_back(r.rhs);
+
+			position.push_back(i);
+		}
+		else if (r.op == OP_LESS_EQ) {
+
+			equalities_only = false;
+		}
+	}
+}
+
+bool interval_ad::square_system() const {
+
+	return equalities_only && number_of_constraints() == n_vars;
+}
+
+bool interval_ad::evaluate(const interval* box) {
+
+	copy(box, box+n_vars, v.begin());
+
+	for (size_t i=0; i<constants.size(); ++i) {
+
+		v.at(constants[i].first) = interval(constants[i].second);
+	}
+
+	for (size_t i=0; i<tape.size(); ++i) {
+
+		if (!evaluate(tape[i])) {
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool interval_ad::evaluate(const tape_record& r) {
+
+	switch (r.op) {
+
+	case OP_ADD: v[r.z] = v[r.x] + v[r.y]; break;
+
+	case OP_SUB: v[r.z] = v[r.x] - v[r.y]; break;
+
+	case OP_MUL: v[r.z] = v[r.x] * v[r.y]; break;
+
+	case OP_DIV:
+
+		if (v[r.y].contains(0)) {
+
+			return false;
+		}
+
+		v[r.z] = v[r.x] / v[r.y];
+		break;
+
+	case OP_SQR: v[r.z] = sqr(v[r.x]); break;
+
+	case OP_EXP: v[r.z] = exp(v[r.x]); break;
+
+	case OP_LOG:
+
+		if (v[r.x].inf() <= 0) {
+
+			return false;
+		}
+
+		v[r.z] = log(v[r.x]);
+		break;
+
+	// The residuals are taken at the bodies, the rest is not differentiated
+	case OP_EQUALITY: case OP_CSE: case OP_LESS_EQ: return true;
+
+	default: ASSERT2(false, "unknown opcode: "<<r.op);
+	}
+
+	return finite(v[r.z]);
+}
+
+bool interval_ad::residuals(const interval* box, std::vector<interval>& f) {
+
+	if (!evaluate(box)) {
+
+		return false;
+	}
+
+	f.resize(body.size());
+
+	for (size_t k=0; k<body.size(); ++k) {
+
+		f[k] = v[body[k]] + (-rhs[k]);
+	}
+
+	return true;
+}
+
+bool interval_ad::jacobian_forward(const interval* box, interval_jacobian& J) {
+
+	if (!evaluate(box)) {
+
+		return false;
+	}
+
+	for (int i=0; i<n_nodes; ++i) {
+
+		grad[i].clear();
+	}
+
+	for (int i=0; i<n_vars; ++i) {
+
+		grad[i].push_back(make_pair(i, interval(1)));
+	}
+
+	for (size_t i=0; i<tape.size(); ++i) {
+
+		differentiate(tape[i]);
+	}
+
+	J.clear();
+
+	for (size_t k=0; k<body.size(); ++k) {
+
+		const gradient& g = grad[body[k]];
+
+		for (size_t i=0; i<g.size(); ++i) {
+
+			J.add(g[i].first, g[i].second);
+		}
+
+		J.finish_row();
+	}
+
+	return true;
+}
+
+void interval_ad::differentiate(const tape_record& r) {
+
+	const interval one(1);
+
+	gradient& z = grad[r.z];
+
+	switch (r.op) {
+
+	case OP_ADD: combine(grad[r.x], one, grad[r.y],  one, z); break;
+
+	case OP_SUB: combine(grad[r.x], one, grad[r.y], -one, z); break;
+
+	case OP_MUL: combine(grad[r.x], v[r.y], grad[r.y], v[r.x], z); break;
+
+	case OP_DIV: combine(grad[r.x], one/v[r.y], grad[r.y], -(v[r.z]/v[r.y]), z); break;
+
+	case OP_SQR: scale(grad[r.x], 2.0*v[r.x], z); break;
+
+	case OP_EXP: scale(grad[r.x], v[r.z], z); break;
+
+	case OP_LOG: scale(grad[r.x], one/v[r.x], z); break;
+
+	default: break;
+	}
+}
+
+// z = cx*x + cy*y, the gradients are sorted by the variable index
+void interval_ad::combine(const gradient& x, const interval& cx, const gradient& y, const interval& cy, gradient& z) {
+
+	z.clear();
+
+	size_t i=0, j=0;
+
+	while (i<x.size() || j<y.size()) {
+
+		if (j==y.size() || (i<x.size() && x[i].first < y[j].first)) {
+
+			z.push_back(make_pair(x[i].first, cx*x[i].second));
+
+			++i;
+		}
+		else if (i==x.size() || y[j].first < x[i].first) {
+
+			z.push_back(make_pair(y[j].first, cy*y[j].second));
+
+			++j;
+		}
+		else {
+
+			z.push_back(make_pair(x[i].first, cx*x[i].second + cy*y[j].second));
+
+			++i;
+			++j;
+		}
+	}
+}
+
+void interval_ad::scale(const gradient& x, const interval& cx, gradient& z) {
+
+	z.clear();
+
+	for (size_t i=0; i<x.size(); ++i) {
+
+		z.push_back(make_pair(x[i].first, cx*x[i].second));
+	}
+}
+
+bool interval_ad::jacobian_reverse(const interval* box, interval_jacobian& J) {
+
+	if (!evaluate(box)) {
+
+		return false;
+	}
+
+	J.clear();
+
+	for (size_t k=0; k<body.size(); ++k) {
+
+		reached.assign(n_nodes, 0);
+
+		accumulate(body[k], interval(1));
+
+		for (int i=position[k]; i>=0; --i) {
+
+			propagate_adjoint(tape[i]);
+		}
+
+		for (int j=0; j<n_vars; ++j) {
+
+			if (reached[j]) {
+
+				J.add(j, adjoint[j]);
+			}
+		}
+
+		J.finish_row();
+	}
+
+	return true;
+}
+
+void interval_ad::propagate_adjoint(const tape_record& r) {
+
+	if (r.op==OP_EQUALITY || r.op==OP_CSE || r.op==OP_LESS_EQ || !reached[r.z]) {
+
+		return;
+	}
+
+	const interval a = adjoint[r.z];
+
+	switch (r.op) {
+
+	case OP_ADD:
+		accumulate(r.x, a);
+		accumulate(r.y, a);
+		break;
+
+	case OP_SUB:
+		accumulate(r.x,  a);
+		accumulate(r.y, -a);
+		break;
+
+	case OP_MUL:
+		accumulate(r.x, a*v[r.y]);
+		accumulate(r.y, a*v[r.x]);
+		break;
+
+	case OP_DIV:
+		accumulate(r.x, a/v[r.y]);
+		accumulate(r.y, -(a*v[r.z]/v[r.y]));
+		break;
+
+	case OP_SQR: accumulate(r.x, a*(2.0*v[r.x])); break;
+
+	case OP_EXP: accumulate(r.x, a*v[r.z]); break;
+
+	case OP_LOG: accumulate(r.x, a/v[r.x]); break;
+
+	default: ASSERT2(false, "unknown opcode: "<<r.op);
+	}
+}
+
+void interval_ad::accumulate(int node, const interval& d) {
+
+	if (reached[node]) {
+
+		adjoint[node] += d;
+	}
+	else {
+
+		adjoint[node] = d;
+
+		reached[node] = 1;
+	}
+}
+
+}
@@ -0,0 +1,517 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include "interval_batch.hpp"
+#include "diagnostics.hpp"
+#include "evaluate.hpp"
+#include "exceptions.hpp"
+#include "floating_point_tol.hpp"
+#include "problem_data.hpp"
+
+using namespace std;
+
+namespace {
+
+const int SIMD_WIDTH = 4; // doubles in an AVX2 register
+
+const int MAX_SWEEPS = 20;
+
+const double PROGRESS_THRESHOLD = 0.01; // relative reduction of the widths
+
+int round_up(int lanes) {
+
+	return ((lanes+SIMD_WIDTH-1)/SIMD_WIDTH)*SIMD_WIDTH;
+}
+
+// Same as interval::is_narrow()
+inline bool narrow(const double lb, const double ub) {
+
+	const double diameter = ub-lb;
+
+	if (diameter < asol::NARROW) {
+
+		return true;
+	}
+
+	const double abs_max = max(fabs(lb), fabs(ub));
+
+	return (diameter/abs_max) < asol::NARROW;
+}
+
+// Same as interval::intersect() except that infeasibility clears alive
+inline void intersect_lane(double& lb, double& ub, const double l, const double u, char& alive) {
+
+	if (!alive || narrow(lb, ub)) {
+
+		return;
+	}
+
+	if (l > asol::add_tol(lb, asol::IMPROVEMENT_TOL)) {
+		lb = l;
+	}
+
+	if (u < asol::sub_tol(ub, asol::IMPROVEMENT_TOL)) {
+		ub = u;
+	}
+
+	if (lb > ub) {
+		alive = 0;
+	}
+}
+
+#ifdef __AVX2__
+
+inline __m256d abs4(const __m256d x) {
+
+	return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+
+inline __m256d alive_mask(const char* alive) {
+
+	const __m256d flags = _mm256_set_pd(alive[3], alive[2], alive[1], alive[0]);
+
+	return _mm256_cmp_pd(flags, _mm256_setzero_pd(), _CMP_NEQ_OQ);
+}
+
+void intersect4(double* zl, double* zu, const double* l, const double* u, char* alive) {
+
+	const __m256d lb = _mm256_loadu_pd(zl);
+	const __m256d ub = _mm256_loadu_pd(zu);
+	const __m256d L  = _mm256_loadu_pd(l);
+	const __m256d U  = _mm256_loadu_pd(u);
+
+	const __m256d live = alive_mask(alive);
+
+	const __m256d tol = _mm256_set1_pd(asol::NARROW);
+
+	const __m256d diam = _mm256_sub_pd(ub, lb);
+
+	const __m256d abs_max = _mm256_max_pd(abs4(lb), abs4(ub));
+
+	const __m256d wide = _mm256_and_pd(_mm256_cmp_pd(diam, tol, _CMP_GE_OQ),
+			_mm256_cmp_pd(_mm256_div_pd(diam, abs_max), tol, _CMP_GE_OQ));
+
+	const __m256d impr = _mm256_set1_pd(asol::IMPROVEMENT_TOL);
+
+	const __m256d lb_tol = _mm256_max_pd(_mm256_add_pd(lb, impr), _mm256_add_pd(lb, _mm256_mul_pd(impr, abs4(lb))));
+
+	const __m256d ub_tol = _mm256_min_pd(_mm256_sub_pd(ub, impr), _mm256_sub_pd(ub, _mm256_mul_pd(impr, abs4(ub))));
+
+	const __m256d update = _mm256_and_pd(live, wide);
+
+	const __m256d new_lb = _mm256_blendv_pd(lb, L, _mm256_and_pd(update, _mm256_cmp_pd(L, lb_tol, _CMP_GT_OQ)));
+
+	const __m256d new_ub = _mm256_blendv_pd(ub, U, _mm256_and_pd(update, _mm256_cmp_pd(U, ub_tol, _CMP_LT_OQ)));
+
+	_mm256_storeu_pd(zl, new_lb);
+	_mm256_storeu_pd(zu, new_ub);
+
+	const int empty = _mm256_movemask_pd(_mm256_and_pd(live, _mm256_cmp_pd(new_lb, new_ub, _CMP_GT_OQ)));
+
+	for (int k=0; k<SIMD_WIDTH; ++k) {
+
+		if (empty & (1 << k)) {
+			alive[k] = 0;
+		}
+	}
+}
+
+#endif
+
+}
+
+namespace asol {
+
+extern const std::vector<tape_record> convert_to_tape(const std::vector<primitive<builder>*>& v);
+
+interval_batch::interval_batch(const problem_data* problem, int lanes) :
+
+	tape     (convert_to_tape(problem->get_primitives())),
+	n_vars   (problem->number_of_variables()),
+	n_nodes  (problem->peek_index()),
+	n_lanes  (lanes),
+	stride   (round_up(lanes)),
+	constants(problem->get_numeric_constants().begin(), problem->get_numeric_constants().end()),
+	lo       (n_nodes*stride, 0.0),
+	up       (n_nodes*stride, 0.0),
+	tmp_lo   (stride, 0.0),
+	tmp_up   (stride, 0.0),
+	alive    (stride, 0),
+	sweep_counter(0)
+{
+	ASSERT2(lanes > 0, "lanes: "<<lanes);
+}
+
+const interval interval_batch::get(int node, int lane) const {
+
+	const int k = node*stride + lane;
+
+	return interval(lo[k], up[k]);
+}
+
+void interval_batch::set(int node, int lane, const interval& x) {
+
+	const int k = node*stride + lane;
+
+	lo[k] = x.unchecked_inf();
+
+	up[k] = x.unchecked_sup();
+}
+
+void interval_batch::set_box(int lane, const interval* box) {
+
+	ASSERT2(0<=lane && lane<n_lanes, "lane: "<<lane);
+
+	for (int i=0; i<n_vars; ++i) {
+
+		set(i, lane, box[i]);
+	}
+
+	for (int i=n_vars; i<n_nodes; ++i) {
+
+		set(i, lane, interval::ANY_REAL());
+	}
+
+	for (size_t i=0; i<constants.size(); ++i) {
+
+		set(constants[i].first, lane, interval(constants[i].second));
+	}
+
+	alive.at(lane) = 1;
+}
+
+void interval_batch::disable(int lane) {
+
+	ASSERT2(0<=lane && lane<n_lanes, "lane: "<<lane);
+
+	alive.at(lane) = 0;
+}
+
+bool interval_batch::feasible(int lane) const {
+
+	ASSERT2(0<=lane && lane<n_lanes, "lane: "<<lane);
+
+	return alive.at(lane) != 0;
+}
+
+void interval_batch::get_box(int lane, interval* box) const {
+
+	ASSERT2(feasible(lane), "lane: "<<lane);
+
+	for (int i=0; i<n_vars; ++i) {
+
+		box[i] = get(i, lane);
+	}
+}
+
+void interval_batch::sum(int x, int y) {
+
+	const double* const xl = lb(x); const double* const xu = ub(x);
+	const double* const yl = lb(y); const double* const yu = ub(y);
+
+	for (int i=0; i<stride; ++i) {
+
+		tmp_lo[i] = xl[i] + yl[i];
+		tmp_up[i] = xu[i] + yu[i];
+	}
+}
+
+void interval_batch::difference(int x, int y) {
+
+	const double* const xl = lb(x); const double* const xu = ub(x);
+	const double* const yl = lb(y); const double* const yu = ub(y);
+
+	for (int i=0; i<stride; ++i) {
+
+		tmp_lo[i] = xl[i] - yu[i];
+		tmp_up[i] = xu[i] - yl[i];
+	}
+}
+
+void interval_batch::product(int x, int y) {
+
+	const double* const xl = lb(x); const double* const xu = ub(x);
+	const double* const yl = lb(y); const double* const yu = ub(y);
+
+	int i = 0;
+
+#ifdef __AVX2__
+
+	for ( ; i<stride; i+=SIMD_WIDTH) {
+
+		const __m256d a = _mm256_loadu_pd(xl+i), b = _mm256_loadu_pd(xu+i);
+		const __m256d c = _mm256_loadu_pd(yl+i), d = _mm256_loadu_pd(yu+i);
+
+		const __m256d ac = _mm256_mul_pd(a, c), ad = _mm256_mul_pd(a, d);
+		const __m256d bc = _mm256_mul_pd(b, c), bd = _mm256_mul_pd(b, d);
+
+		_mm256_storeu_pd(&tmp_lo[i], _mm256_min_pd(_mm256_min_pd(ac, ad), _mm256_min_pd(bc, bd)));
+		_mm256_storeu_pd(&tmp_up[i], _mm256_max_pd(_mm256_max_pd(ac, ad), _mm256_max_pd(bc, bd)));
+	}
+
+#endif
+
+	for ( ; i<stride; ++i) {
+
+		const double z[] = { xl[i]*yl[i], xl[i]*yu[i], xu[i]*yl[i], xu[i]*yu[i] };
+
+		tmp_lo[i] = *min_element(z, z+4);
+		tmp_up[i] = *max_element(z, z+4);
+	}
+}
+
+void interval_batch::intersect(int z) {
+
+	double* const zl = lb(z);
+	double* const zu = ub(z);
+
+	int i = 0;
+
+#ifdef __AVX2__
+
+	for ( ; i<stride; i+=SIMD_WIDTH) {
+
+		intersect4(zl+i, zu+i, &tmp_lo[i], &tmp_up[i], &alive[i]);
+	}
+
+#endif
+
+	for ( ; i<stride; ++i) {
+
+		intersect_lane(zl[i], zu[i], tmp_lo[i], tmp_up[i], alive[i]);
+	}
+}
+
+void interval_batch::equals(int z, double rhs) {
+
+	fill(tmp_lo.begin(), tmp_lo.end(), rhs);
+
+	fill(tmp_up.begin(), tmp_up.end(), rhs);
+
+	intersect(z);
+}
+
+void interval_batch::evaluate_all() {
+
+	const int size = static_cast<int>(tape.size());
+
+	for (int i=0; i<size; ++i) {
+
+		const tape_record& r = tape[i];
+
+		switch (r.op) {
+
+		case OP_ADD: sum(r.x, r.y); intersect(r.z); break;
+
+		case OP_SUB: difference(r.x, r.y); intersect(r.z); break;
+
+		case OP_MUL: product(r.x, r.y); intersect(r.z); break;
+
+		case OP_EQUALITY: equals(r.z, r.rhs); break;
+
+		case OP_CSE: break; // TODO Not clear what to do
+
+		default: scalar_evaluate(r);
+		}
+	}
+}
+
+void interval_batch::revise_all() {
+
+	for (int i=static_cast<int>(tape.size())-1; i>=0; --i) {
+
+		const tape_record& r = tape[i];
+
+		switch (r.op) {
+
+		case OP_ADD: // addition_inverse(z, x, y)
+			difference(r.z, r.y); intersect(r.x);
+			difference(r.z, r.x); intersect(r.y);
+			sum(r.x, r.y);        intersect(r.z);
+			break;
+
+		case OP_SUB: // addition_inverse(x, z, y)
+			difference(r.x, r.y); intersect(r.z);
+			difference(r.x, r.z); intersect(r.y);
+			sum(r.z, r.y);        intersect(r.x);
+			break;
+
+		case OP_EQUALITY: equals(r.z, r.rhs); break;
+
+		case OP_CSE: break; // TODO Not clear what to do
+
+		default: scalar_revise(r);
+		}
+	}
+}
+
+void interval_batch::scalar_evaluate(const tape_record& r) {
+
+	for (int lane=0; lane<n_lanes; ++lane) {
+
+		if (!alive[lane]) {
+			continue;
+		}
+
+		interval z = get(r.z, lane), x = get(r.x, lane);
+
+		try {
+
+			switch (r.op) {
+
+			// Arg2 cannot contain zero, extended division is not applicable
+			case OP_DIV: div(z, x, get(r.y, lane)); break;
+
+			case OP_SQR: sqr(z, x); break;
+
+			case OP_EXP: exp(z, x); break;
+
+			case OP_LOG: log(z, x); break;
+
+			case OP_LESS_EQ: z.less_than_or_equal_to(x); break;
+
+			default: ASSERT2(false, "unexpected opcode: "<<r.op);
+			}
+		}
+		catch (infeasible_problem& ) {
+
+			alive[lane] = 0;
+
+			continue;
+		}
+
+		set(r.z, lane, z);
+
+		set(r.x, lane, x);
+	}
+}
+
+void interval_batch::scalar_revise(const tape_record& r) {
+
+	for (int lane=0; lane<n_lanes; ++lane) {
+
+		if (!alive[lane]) {
+			continue;
+		}
+
+		interval z = get(r.z, lane), x = get(r.x, lane);
+
+		interval y = (r.y >= 0) ? get(r.y, lane) : interval();
+
+		interval gap;
+
+		try {
+
+			switch (r.op) {
+
+			case OP_MUL:
+				extended_division(z, x, y, gap);
+				extended_division(z, y, x, gap);
+				asol::mul(z, x, y);
+				break;
+
+			case OP_DIV: division_inverse(z, x, y, gap); break;
+
+			case OP_SQR: sqr_inverse(z, x, gap); break;
+
+			case OP_EXP: exp_inverse(z, x); break;
+
+			case OP_LOG: log_inverse(z, x); break;
+
+			// TODO Is this the best we can do?
+			case OP_LESS_EQ: z.less_than_or_equal_to(x); break;
+
+			default: ASSERT2(false, "unexpected opcode: "<<r.op);
+			}
+		}
+		catch (infeasible_problem& ) {
+
+			alive[lane] = 0;
+
+			continue;
+		}
+
+		set(r.z, lane, z);
+
+		set(r.x, lane, x);
+
+		if (r.y >= 0) {
+
+			set(r.y, lane, y);
+		}
+	}
+}
+
+double interval_batch::sum_of_widths(int lane) const {
+
+	double result = 0.0;
+
+	for (int i=0; i<n_vars; ++i) {
+
+		const int k = i*stride + lane;
+
+		result += up[k] - lo[k];
+	}
+
+	return result;
+}
+
+bool interval_batch::any_progress(const vector<double>& widths_before) const {
+
+	for (int lane=0; lane<n_lanes; ++lane) {
+
+		if (alive[lane] && sum_of_widths(lane) < (1.0-PROGRESS_THRESHOLD)*widths_before[lane]) {
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void interval_batch::iterative_revision() {
+
+	sweep_counter = 0;
+
+	vector<double> widths(n_lanes);
+
+	do {
+
+		for (int lane=0; lane<n_lanes; ++lane) {
+
+			widths[lane] = alive[lane] ? sum_of_widths(lane) : 0.0;
+		}
+
+		evaluate_all();
+
+		revise_all();
+
+		++sweep_counter;
+	}
+	while (any_progress(widths) && sweep_counter < MAX_SWEEPS);
+}
+
+}
@@ -0,0 +1,273 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include "interval_newton.hpp"
+#include "diagnostics.hpp"
+#include "problem_data.hpp"
+
+using namespace std;
+
+namespace {
+
+const double TOL_SINGULAR = 1.0e-12; // relative to the largest entry
+
+bool strictly_inside(const asol::interval& x, const asol::interval& y) {
+
+	return y.inf() < x.inf() && x.sup() < y.sup();
+}
+
+bool finite(const asol::interval& x) {
+
+	return x.valid() && std::fabs(x.inf()) <= 1.0e+150 && std::fabs(x.sup()) <= 1.0e+150;
+}
+
+}
+
+namespace asol {
+
+interval_newton::interval_newton(const problem_data* problem, newton_method m)
+: ad(problem), method(m), n(problem->number_of_variables()), Y(n*n), c(n), fc(n), A(n*n), b(n), proof_count(0)
+{
+
+}
+
+bool interval_newton::contract(interval* box) {
+
+	if (!applicable()) {
+
+		return false;
+	}
+
+	vector<interval> midpoint(n);
+
+	for (int i=0; i<n; ++i) {
+
+		c[i] = box[i].midpoint();
+
+		midpoint[i] = interval(c[i]);
+	}
+
+	if (!ad.residuals(&midpoint[0], fc) || !ad.jacobian_reverse(box, J) || !precondition()) {
+
+		return false;
+	}
+
+	preconditioned_system();
+
+	const bool unique = (method == NEWTON_GAUSS_SEIDEL) ? gauss_seidel(box) : krawczyk(box);
+
+	if (unique) {
+
+		++proof_count;
+	}
+
+	return unique;
+}
+
+// Gauss-Jordan elimination with partial pivoting on the midpoint matrix
+bool interval_newton::precondition() {
+
+	vector<double> M(n*n, 0.0);
+
+	double max_abs = 0.0;
+
+	for (int k=0; k<n; ++k) {
+
+		for (int p=J.start[k]; p<J.start[k+1]; ++p) {
+
+			M[k*n+J.col[p]] = J.val[p].midpoint();
+
+			max_abs = max(max_abs, fabs(M[k*n+J.col[p]]));
+		}
+	}
+
+	fill(Y.begin(), Y.end(), 0.0);
+
+	for (int i=0; i<n; ++i) {
+
+		Y[i*n+i] = 1.0;
+	}
+
+	for (int j=0; j<n; ++j) {
+
+		int pivot = j;
+
+		for (int i=j+1; i<n; ++i) {
+
+			if (fabs(M[i*n+j]) > fabs(M[pivot*n+j])) {
+
+				pivot = i;
+			}
+		}
+
+		if (!(fabs(M[pivot*n+j]) > TOL_SINGULAR*max_abs)) {
+
+			return false;
+		}
+
+		if (pivot != j) {
+
+			swap_ranges(M.begin()+j*n, M.begin()+(j+1)*n, M.begin()+pivot*n);
+
+			swap_ranges(Y.begin()+j*n, Y.begin()+(j+1)*n, Y.begin()+pivot*n);
+		}
+
+		const double d = M[j*n+j];
+
+		for (int k=0; k<n; ++k) {
+
+			M[j*n+k] /= d;
+
+			Y[j*n+k] /= d;
+		}
+
+		for (int i=0; i<n; ++i) {
+
+			const double f = M[i*n+j];
+
+			if (i==j || f==0) {
+
+				continue;
+			}
+
+			for (int k=0; k<n; ++k) {
+
+				M[i*n+k] -= f*M[j*n+k];
+
+				Y[i*n+k] -= f*Y[j*n+k];
+			}
+		}
+	}
+
+	return true;
+}
+
+void interval_newton::preconditioned_system() {
+
+	fill(A.begin(), A.end(), interval(0));
+
+	fill(b.begin(), b.end(), interval(0));
+
+	for (int k=0; k<n; ++k) {
+
+		for (int i=0; i<n; ++i) {
+
+			const double y = Y[i*n+k];
+
+			if (y == 0) {
+
+				continue;
+			}
+
+			for (int p=J.start[k]; p<J.start[k+1]; ++p) {
+
+				A[i*n+J.col[p]] += y*J.val[p];
+			}
+
+			b[i] += y*fc[k];
+		}
+	}
+}
+
+// Each component is contracted with the ones already contracted in this
+// sweep (Hansen-Sengupta); uniqueness needs all of them strictly inside
+bool interval_newton::gauss_seidel(interval* box) const {
+
+	bool unique = true;
+
+	for (int i=0; i<n; ++i) {
+
+		const interval& a_ii = A[i*n+i];
+
+		if (a_ii.contains(0)) {
+
+			unique = false;
+
+			continue;
+		}
+
+		interval s = b[i];
+
+		for (int j=0; j<n; ++j) {
+
+			if (j != i) {
+
+				s += A[i*n+j]*(box[j] + (-c[j]));
+			}
+		}
+
+		const interval N = -(s/a_ii) + c[i];
+
+		if (!finite(N)) {
+
+			unique = false;
+
+			continue;
+		}
+
+		unique = unique && strictly_inside(N, box[i]);
+
+		box[i].intersect(N);
+	}
+
+	return unique;
+}
+
+// K = c - b + (I - A)(X - c), uniqueness if K is strictly inside X
+bool interval_newton::krawczyk(interval* box) const {
+
+	vector<interval> K(n);
+
+	bool unique = true;
+
+	for (int i=0; i<n; ++i) {
+
+		interval k = -b[i] + c[i];
+
+		for (int j=0; j<n; ++j) {
+
+			const interval I_minus_A = (i==j) ? -A[i*n+j] + 1.0 : -A[i*n+j];
+
+			k += I_minus_A*(box[j] + (-c[j]));
+		}
+
+		if (!finite(k)) {
+
+			return false;
+		}
+
+		unique = unique && strictly_inside(k, box[i]);
+
+		K[i] = k;
+	}
+
+	for (int i=0; i<n; ++i) {
+
+		box[i].intersect(K[i]);
+	}
+
+	return unique;
+}
+
+}
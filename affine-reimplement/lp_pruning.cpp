@@ -22,12 +22,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include "lp_pruning.hpp"
 #include "lp_impl.hpp"
 #include "diagnostics.hpp"
 #include "exceptions.hpp"
+#include "rounding_mode.hpp"
+#include "threads.hpp"
 
 using std::vector;
 
@@ -35,13 +38,25 @@ namespace {
 
 const double TOL_LP_PRUNING_SOLVED = 1.0e-8;
 
+const double TOL_REDUCED_COST = 1.0e-9;
+
+// bound + gap/d rounded in the given direction
+double rounded(double bound, double gap, double d, asol::rounding_mode::direction dir) {
+
+	asol::rounding_mode mode(dir);
+
+	return bound + gap/d;
+}
+
 }
 
 namespace asol {
 
-lp_pruning::lp_pruning(lp_impl* lp, const vector<int>& index_set)
+lp_pruning::lp_pruning(lp_impl* lp, const vector<int>& index_set, int threads)
 :
 lp(lp),
+threads(threads),
+aborted(false),
 index_set(index_set),
 
 size(index_set.size()),
@@ -52,7 +67,16 @@ max_solved(size, 'n'),
 lo(size, 10.0),
 up(size,-10.0),
 
-skipped(0)
+last_val(size, std::numeric_limits<double>::quiet_NaN()),
+
+min_stamp(size, 0),
+max_stamp(size, 0),
+
+skipped(0),
+
+tightened(0),
+
+solves(0)
 
 {
 	init_reverse_index_set();
@@ -141,25 +165,38 @@ void lp_pruning::prune_all() {
 
 void lp_pruning::prune() {
 
+	if (threads > 1) {
+
+		prune_in_parallel();
+
+		return;
+	}
+
 	//count_solved();
 
 	size_t lp_call = 0;
 
 	subproblem next;
 
-	while ( (next=select_candidate()) != NO_MORE ) {
+	while ( (next=select_candidate(lp)) != NO_MORE ) {
 
 		//count_solved();
 
+		const int i = claim(next);
+
+		const int index = index_set.at(i);
+
 		if (next == MIN_SUBPROBLEM) {
 
-			solve_for_lb();
+			store_bound(next, i, lp->tighten_col_lb(index, lo.at(i)));
 		}
 		else {
 
-			solve_for_ub();
+			store_bound(next, i, lp->tighten_col_ub(index, up.at(i)));
 		}
 
+		tighten_by_reduced_costs(lp, next, i);
+
 		++lp_call;
 	}
 
@@ -187,24 +224,40 @@ void lp_pruning::count_solved() const {
 	}
 
 	std::cout << "Solved: " << solved << "/" << 2*size << ", ";
-	std::cout << "skipped: " << skipped << std::endl;
+	std::cout << "skipped: " << skipped << ", ";
+	std::cout << "tightened by reduced costs: " << tightened << std::endl;
 }
 
-lp_pruning::subproblem lp_pruning::select_candidate() {
+// The subproblems are selected by the solution of the last LP solved on solver
+lp_pruning::subproblem lp_pruning::select_candidate(const lp_impl* solver) {
 
 	closest_min = closest_max = std::numeric_limits<double>::max();
 
 	index_min = index_max = -1;
 
+	if (aborted) {
+
+		return NO_MORE;
+	}
+
 	for (size_t i=0; i<size; ++i) {
 
-		double val = lp->col_val(index_set.at(i));
+		double val = solver->col_val(index_set.at(i));
+
+		if (val != last_val.at(i)) {
+
+			last_val.at(i) = val;
 
-		examine_lb(i, val);
+			examine_lb(i, val);
 
-		examine_ub(i, val);
+			examine_ub(i, val);
+		}
 	}
 
+	closest(min_heap, min_stamp, min_solved, index_min, closest_min);
+
+	closest(max_heap, max_stamp, max_solved, index_max, closest_max);
+
 	dbg_selection_results();
 
 	subproblem next;
@@ -234,7 +287,9 @@ void lp_pruning::examine_lb(int i, double val) {
 
 	double distance_from_lb = val-lo.at(i);
 
-	ASSERT(distance_from_lb >= 0);
+	// Slightly negative if the backend solves within tolerances, see
+	// lp_impl::primal_tolerance()
+	ASSERT2(distance_from_lb >= -lp->primal_tolerance(), "distance from lb: "<<distance_from_lb);
 
 	if (distance_from_lb <= TOL_LP_PRUNING_SOLVED) {
 
@@ -242,11 +297,9 @@ void lp_pruning::examine_lb(int i, double val) {
 
 		++skipped;
 	}
-	else if (distance_from_lb < closest_min) {
-
-		closest_min = distance_from_lb;
+	else {
 
-		index_min = i;
+		push_candidate(min_heap, min_stamp, min_solved, i, distance_from_lb);
 	}
 }
 
@@ -259,7 +312,7 @@ void lp_pruning::examine_ub(int i, double val) {
 
 	double distance_from_ub = up.at(i)-val;
 
-	ASSERT(distance_from_ub >= 0);
+	ASSERT2(distance_from_ub >= -lp->primal_tolerance(), "distance from ub: "<<distance_from_ub);
 
 	if (distance_from_ub <= TOL_LP_PRUNING_SOLVED) {
 
@@ -267,38 +320,364 @@ void lp_pruning::examine_ub(int i, double val) {
 
 		++skipped;
 	}
-	else if (distance_from_ub < closest_max) {
+	else {
+
+		push_candidate(max_heap, max_stamp, max_solved, i, distance_from_ub);
+	}
+}
+
+// At most one candidate per position is live, so once the heap holds more
+// than twice as many entries as positions, most of them are solved or
+// outdated; they are dropped and the heap is rebuilt. The cost is amortized
+// over the pushes that made them stale.
+void lp_pruning::push_candidate(candidate_heap& heap, vector<int>& stamps, const vector<char>& solved,
+                                int i, double distance) {
 
-		closest_max = distance_from_ub;
+	heap.push_back(candidate(distance, i, ++stamps.at(i)));
 
-		index_max = i;
+	if (heap.size() <= 2*size) {
+
+		std::push_heap(heap.begin(), heap.end(), std::greater<candidate>());
+
+		return;
 	}
+
+	heap.erase(std::remove_if(heap.begin(), heap.end(), not_live(stamps, solved)), heap.end());
+
+	std::make_heap(heap.begin(), heap.end(), std::greater<candidate>());
 }
 
-void lp_pruning::solve_for_lb() {
+// Drops the solved and the outdated candidates from the top of the heap
+void lp_pruning::closest(candidate_heap& heap, const vector<int>& stamps, const vector<char>& solved,
+                         int& index, double& distance) {
+
+	const not_live dropped(stamps, solved);
 
-	min_solved.at(index_min) = 'y';
+	while (!heap.empty()) {
 
-	const int index = index_set.at(index_min);
+		const candidate& top = heap.front();
 
-	const double old_lb = lo.at(index_min);
+		if (!dropped(top)) {
 
-	lo.at(index_min) = lp->tighten_col_lb(index, old_lb);
+			index = top.i;
 
-//	save_reduced_costs(index, d_min);
+			distance = top.distance;
+
+			return;
+		}
+
+		std::pop_heap(heap.begin(), heap.end(), std::greater<candidate>());
+
+		heap.pop_back();
+	}
 }
 
-void lp_pruning::solve_for_ub() {
+// Marks the selected subproblem as solved, returns its position in index_set
+int lp_pruning::claim(subproblem next) {
+
+	int i;
+
+	if (next == MIN_SUBPROBLEM) {
 
-	max_solved.at(index_max) = 'y';
+		i = index_min;
 
-	const int index = index_set.at(index_max);
+		min_solved.at(i) = 'y';
+	}
+	else {
+
+		i = index_max;
+
+		max_solved.at(i) = 'y';
+	}
+
+	return i;
+}
+
+void lp_pruning::store_bound(subproblem solved, int i, double bound) {
+
+	if (solved == MIN_SUBPROBLEM) {
+
+		lo.at(i) = bound;
+	}
+	else {
+
+		up.at(i) = bound;
+	}
+
+//	save_reduced_costs(index_set.at(i), solved == MIN_SUBPROBLEM ? d_min : d_max);
+}
+
+// After min x_i = z on solver, for any feasible point
+//   x_i = z + sum d_j*(x_j - x_j*)
+// over the nonbasic columns, each term being nonnegative at the optimum.
+// As x_i <= up_i, each term is at most up_i - z, which bounds x_j from
+// above if it sits at its lower bound and from below if at its upper one.
+// The same holds for max x_i with the signs flipped and lo_i instead.
+// The new bound of x_i, just stored, is taken for z: a rigorous_lp_impl
+// verifies both the bound and the reduced costs, and the new bounds are
+// rounded outward. A bound attained by the last seen solution marks its
+// subproblem solved on the next selection.
+void lp_pruning::tighten_by_reduced_costs(const lp_impl* solver, subproblem solved, int i) {
+
+	if (!solver->has_reduced_costs()) {
+
+		return;
+	}
+
+	const int index_i = index_set.at(i);
+
+	double gap;
+
+	{
+		rounding_mode mode(rounding_mode::UPWARD);
+
+		gap = up.at(i) - lo.at(i);
+	}
+
+	if (gap < 0) {
+
+		return; // numerical noise, the bound of x_i is attained
+	}
+
+	const double sense = (solved == MIN_SUBPROBLEM) ? 1.0 : -1.0;
+
+	const int n_cols = solver->num_cols();
+
+	for (int j=1; j<=n_cols; ++j) {
+
+		const int pos = reverse_index_set.at(j);
+
+		if (pos < 0 || j == index_i) {
+
+			continue;
+		}
+
+		// Nonnegative at the lower bound, nonpositive at the upper one
+		const double d = sense*solver->col_dual_val(j);
+
+		const col_status status = solver->col_stat(j);
+
+		if (status == NONBASIC_LB && d > TOL_REDUCED_COST) {
+
+			tighten_ub(pos, rounded(solver->col_lb(j), gap, d, rounding_mode::UPWARD));
+		}
+		else if (status == NONBASIC_UB && d < -TOL_REDUCED_COST) {
+
+			tighten_lb(pos, rounded(solver->col_ub(j), gap, d, rounding_mode::DOWNWARD));
+		}
+	}
+}
+
+// Never past the last seen value, that is feasible up to rounding
+void lp_pruning::tighten_lb(int pos, double bound) {
+
+	const double val = last_val.at(pos);
+
+	if (val == val && bound > val) { // val is not NaN
+
+		bound = val;
+	}
+
+	if (min_solved.at(pos)=='y' || bound <= lo.at(pos) || bound > up.at(pos)) {
+
+		return;
+	}
 
-	const double old_ub = up.at(index_max);
+	lo.at(pos) = bound;
 
-	up.at(index_max) = lp->tighten_col_ub(index, old_ub);
+	++tightened;
 
-//	save_reduced_costs(index, d_max);
+	if (val == val) {
+
+		examine_lb(pos, val);
+	}
+}
+
+void lp_pruning::tighten_ub(int pos, double bound) {
+
+	const double val = last_val.at(pos);
+
+	if (val == val && bound < val) {
+
+		bound = val;
+	}
+
+	if (max_solved.at(pos)=='y' || bound >= up.at(pos) || bound < lo.at(pos)) {
+
+		return;
+	}
+
+	up.at(pos) = bound;
+
+	++tightened;
+
+	if (val == val) {
+
+		examine_ub(pos, val);
+	}
+}
+
+// Solves the subproblems on its own clone of the LP; the selection and the
+// bounds are shared with the other workers through the pruning object
+class pruning_worker : public runnable {
+
+public:
+
+	explicit pruning_worker(lp_pruning& pruning)
+	: solver(pruning.lp->clone()), lp_calls(0), last_solve(0), infeasible(false), numerical(false), p(pruning), values(pruning.lp)
+	{ }
+
+	virtual void run() {
+
+		try {
+
+			solve_subproblems();
+		}
+		catch (infeasible_problem& ) {
+
+			infeasible = true;
+		}
+		catch (numerical_problems& ) {
+
+			numerical = true;
+		}
+
+		if (infeasible || numerical) {
+
+			scoped_lock lock(p.state_lock);
+
+			p.aborted = true;
+		}
+	}
+
+	~pruning_worker() { delete solver; }
+
+	lp_impl* const solver;
+
+	size_t lp_calls;
+
+	size_t last_solve; // see lp_pruning::solves, 0 if none
+
+	bool infeasible;
+
+	bool numerical;
+
+private:
+
+	pruning_worker(const pruning_worker& );
+	pruning_worker& operator=(const pruning_worker& );
+
+	void solve_subproblems() {
+
+		for ( ; ; ) {
+
+			lp_pruning::subproblem next;
+
+			int i;
+
+			double old_bound;
+
+			{
+				scoped_lock lock(p.state_lock);
+
+				next = p.select_candidate(values);
+
+				if (next == lp_pruning::NO_MORE) {
+
+					return;
+				}
+
+				i = p.claim(next);
+
+				old_bound = (next == lp_pruning::MIN_SUBPROBLEM) ? p.lo.at(i) : p.up.at(i);
+			}
+
+			const int index = p.index_set.at(i);
+
+			const double bound = (next == lp_pruning::MIN_SUBPROBLEM) ?
+					solver->tighten_col_lb(index, old_bound) :
+					solver->tighten_col_ub(index, old_bound);
+
+			values = solver; // its own solution is available from now on
+
+			++lp_calls;
+
+			scoped_lock lock(p.state_lock);
+
+			p.store_bound(next, i, bound);
+
+			p.tighten_by_reduced_costs(solver, next, i);
+
+			last_solve = ++p.solves;
+		}
+	}
+
+	lp_pruning& p;
+
+	const lp_impl* values;
+};
+
+void lp_pruning::prune_in_parallel() {
+
+	std::vector<pruning_worker*> workers;
+
+	std::vector<runnable*> tasks;
+
+	for (int k=0; k<threads; ++k) {
+
+		workers.push_back(new pruning_worker(*this));
+
+		tasks.push_back(workers.back());
+	}
+
+	run_in_parallel(tasks);
+
+	size_t lp_call = 0;
+
+	bool infeasible = false, numerical = false;
+
+	const pruning_worker* last = workers.at(0);
+
+	for (int k=0; k<threads; ++k) {
+
+		lp_call += workers.at(k)->lp_calls;
+
+		infeasible = infeasible || workers.at(k)->infeasible;
+
+		numerical  = numerical  || workers.at(k)->numerical;
+
+		if (workers.at(k)->last_solve > last->last_solve) {
+
+			last = workers.at(k);
+		}
+	}
+
+	// As after prune(), lp is left with the basis of the last subproblem; the
+	// warm starts of the child boxes are taken from it, see lp_solver
+	if (!infeasible && !numerical && last->last_solve > 0) {
+
+		lp_basis basis;
+
+		last->solver->save_basis(basis);
+
+		lp->load_basis(basis);
+	}
+
+	for (int k=0; k<threads; ++k) {
+
+		delete workers.at(k);
+	}
+
+	if (infeasible) {
+
+		throw infeasible_problem();
+	}
+	else if (numerical) {
+
+		throw numerical_problems();
+	}
+
+	ASSERT(lp_call+skipped==2*size);
 }
 
 void lp_pruning::save_reduced_costs(int index, vector<vector<double> >& d) {
@@ -26,22 +26,64 @@
 #include "lp_solver.hpp"
 #include "affine.hpp"
 #include "diagnostics.hpp"
+#include "exceptions.hpp"
 #include "port_impl.hpp"
+#include "glpk_impl.hpp"
+#include "dual_simplex_impl.hpp"
+#include "rigorous_lp_impl.hpp"
+#include "lp_trace.hpp"
 #include "lp_pruning.hpp"
 
 using std::vector;
 
+namespace {
+
+const int FARKAS_CACHE_SIZE = 8;
+
+}
+
 namespace asol {
 
-lp_solver::lp_solver() : lp(new port_impl), N_VARS(-1), TINY(1.0e-7), v(0) {
+lp_solver::lp_solver(lp_backend backend_type)
+: backend(backend_type), lp(new_lp_impl(backend_type)), N_VARS(-1), TINY(1.0e-7), pruning_threads(1), v(0), has_initial_basis(false),
+  certificates(FARKAS_CACHE_SIZE)
+{
+
+}
+
+// The bounds are verified if the backend provides the duals, see rigorous_lp_impl
+lp_impl* lp_solver::new_lp_impl(lp_backend backend) {
+
+	lp_impl* impl = 0;
+
+	if (backend == LP_PORT) {
+
+		impl = new port_impl;
+	}
+	else if (backend == LP_GLPK) {
+
+		impl = new rigorous_lp_impl(new glpk_impl);
+	}
+	else if (backend == LP_DUAL_SIMPLEX) {
+
+		impl = new rigorous_lp_impl(new dual_simplex_impl);
+	}
+	else {
+
+		ASSERT2(false, "unknown LP backend: "<<backend);
+	}
 
+	return impl;
 }
 
 void lp_solver::reset() {
 
 	lp->reset();
 
-	lp->add_cols(N_VARS);
+	if (lp->num_cols() == 0) {
+
+		lp->add_cols(N_VARS);
+	}
 }
 
 void lp_solver::set_number_of_vars(int n) {
@@ -51,6 +93,15 @@ void lp_solver::set_number_of_vars(int n) {
 	N_VARS = n;
 }
 
+void lp_solver::set_pruning_threads(int n) {
+
+	ASSERT2(n > 0, "n: "<<n);
+
+	ASSERT2(n == 1 || backend == LP_DUAL_SIMPLEX, "parallel pruning needs the dual simplex, backend: "<<backend);
+
+	pruning_threads = n;
+}
+
 void lp_solver::set_affine_vars(std::vector<affine>* v_of_expression_graph) {
 
 	v = v_of_expression_graph;
@@ -223,7 +274,56 @@ const lp_solver::row_rad_max_aij lp_solver::get_row_rad_max_aij(const affine& x)
 
 void lp_solver::check_feasibility() {
 
-	lp->run_simplex();
+	const bool warm_start = has_initial_basis;
+
+	has_initial_basis = false;
+
+	const sparse_rows* const rows = lp->recorded_rows();
+
+	if (rows && certificates.proves_infeasible(*rows, N_VARS)) {
+
+		throw infeasible_problem();
+	}
+
+	if (warm_start) {
+
+		lp->load_basis(initial_basis);
+	}
+
+	try {
+
+		lp->run_simplex();
+	}
+	catch (infeasible_problem& ) {
+
+		save_certificate();
+
+		throw;
+	}
+}
+
+void lp_solver::save_certificate() {
+
+	const sparse_rows* const rows = lp->recorded_rows();
+
+	vector<double> y;
+
+	if (rows && lp->infeasibility_certificate(y)) {
+
+		certificates.add(y, *rows, N_VARS);
+	}
+}
+
+void lp_solver::save_basis(lp_basis& basis) const {
+
+	lp->save_basis(basis);
+}
+
+void lp_solver::warm_start(const lp_basis& basis) {
+
+	initial_basis = basis;
+
+	has_initial_basis = true;
 }
 
 void lp_solver::set_col_bounds() {
@@ -248,7 +348,7 @@ void lp_solver::prune(const vector<int>& ) {
 		index_set.push_back(i);
 	}
 
-	lp_pruning contractor(lp, index_set);
+	lp_pruning contractor(lp, index_set, pruning_threads);
 
 	const vector<double>& lo = contractor.new_lb_for_epsilon();
 
@@ -267,6 +367,18 @@ void lp_solver::prune(const vector<int>& ) {
 void lp_solver::show_iteration_count() const {
 
 	lp->show_iteration_count();
+
+	std::cout << "Infeasible LPs proved by cached certificates: " << certificates.hits() << std::endl;
+}
+
+uint64_t lp_solver::iteration_count() const {
+
+	return lp->iteration_count();
+}
+
+void lp_solver::capture_trace(const char* file) {
+
+	lp = new lp_trace_recorder(lp, file);
 }
 
 lp_solver::~lp_solver() {
@@ -0,0 +1,437 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstring>
+#include <sys/time.h>
+#include "lp_trace.hpp"
+#include "diagnostics.hpp"
+#include "exceptions.hpp"
+
+using std::vector;
+
+namespace {
+
+const char MAGIC[] = "ASOLLPT1";
+
+const int MAGIC_SIZE = 8;
+
+const double TOL_DISCREPANCY = 1.0e-6;
+
+double wall_time() {
+
+	timeval t;
+
+	gettimeofday(&t, 0);
+
+	return t.tv_sec + t.tv_usec*1.0e-6;
+}
+
+template <typename T>
+void write_value(std::ofstream& out, const T& value) {
+
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::ifstream& in, T& value) {
+
+	in.read(reinterpret_cast<char*>(&value), sizeof(T));
+
+	return in.good();
+}
+
+}
+
+namespace asol {
+
+trace_record::trace_record()
+: event(TRACE_RESET), index(0), outcome(TRACE_SOLVED), lb(0.0), ub(0.0), result(0.0)
+{
+
+}
+
+trace_record::trace_record(int event, int index, double lb, double ub)
+: event(event), index(index), outcome(TRACE_SOLVED), lb(lb), ub(ub), result(0.0)
+{
+
+}
+
+lp_trace_recorder::lp_trace_recorder(lp_impl* solver, const char* file)
+: lp(solver), out(file, std::ios::binary)
+{
+	ASSERT2(out, "failed to open the trace file "<<file);
+
+	out.write(MAGIC, MAGIC_SIZE);
+}
+
+lp_trace_recorder::~lp_trace_recorder() {
+
+	delete lp;
+}
+
+lp_impl* lp_trace_recorder::clone() const {
+
+	return lp->clone();
+}
+
+void lp_trace_recorder::write(const trace_record& rec) {
+
+	write_value(out, rec.event);
+	write_value(out, rec.index);
+	write_value(out, rec.outcome);
+	write_value(out, rec.lb);
+	write_value(out, rec.ub);
+	write_value(out, rec.result);
+
+	if (rec.event == TRACE_ADD_ROW) {
+
+		out.write(reinterpret_cast<const char*>(&rec.cols.at(1)),   rec.index*sizeof(int));
+
+		out.write(reinterpret_cast<const char*>(&rec.coeffs.at(1)), rec.index*sizeof(double));
+	}
+
+	ASSERT2(out, "failed to write the trace");
+}
+
+void lp_trace_recorder::reset() {
+
+	lp->reset();
+
+	const trace_record rec(TRACE_RESET, 0);
+
+	write(rec);
+}
+
+void lp_trace_recorder::add_cols(int n) {
+
+	lp->add_cols(n);
+
+	const trace_record rec(TRACE_ADD_COLS, n);
+
+	write(rec);
+}
+
+void lp_trace_recorder::add_eq_row(const int index[], const double value[], int length, double lb, double ub) {
+
+	lp->add_eq_row(index, value, length, lb, ub);
+
+	trace_record rec(TRACE_ADD_ROW, length, lb, ub);
+
+	rec.cols.assign(index, index+length+1);
+
+	rec.coeffs.assign(value, value+length+1);
+
+	write(rec);
+}
+
+void lp_trace_recorder::set_col_bounds(int index, double lb, double ub) {
+
+	lp->set_col_bounds(index, lb, ub);
+
+	const trace_record rec(TRACE_COL_BOUNDS, index, lb, ub);
+
+	write(rec);
+}
+
+void lp_trace_recorder::run_simplex() {
+
+	trace_record rec(TRACE_RUN_SIMPLEX, 0);
+
+	try {
+
+		lp->run_simplex();
+	}
+	catch (infeasible_problem& ) {
+
+		rec.outcome = TRACE_INFEASIBLE;
+
+		write(rec);
+
+		throw;
+	}
+	catch (numerical_problems& ) {
+
+		rec.outcome = TRACE_NUMERICAL_PROBLEMS;
+
+		write(rec);
+
+		throw;
+	}
+
+	write(rec);
+}
+
+double lp_trace_recorder::tighten_col_lb(int i, const double lb) {
+
+	return tighten(TRACE_TIGHTEN_LB, i, lb);
+}
+
+double lp_trace_recorder::tighten_col_ub(int i, const double ub) {
+
+	return tighten(TRACE_TIGHTEN_UB, i, ub);
+}
+
+double lp_trace_recorder::tighten(int event, int i, double bound) {
+
+	trace_record rec(event, i, bound);
+
+	try {
+
+		rec.result = (event == TRACE_TIGHTEN_LB) ? lp->tighten_col_lb(i, bound) : lp->tighten_col_ub(i, bound);
+	}
+	catch (infeasible_problem& ) {
+
+		rec.outcome = TRACE_INFEASIBLE;
+
+		write(rec);
+
+		throw;
+	}
+	catch (numerical_problems& ) {
+
+		rec.outcome = TRACE_NUMERICAL_PROBLEMS;
+
+		write(rec);
+
+		throw;
+	}
+
+	write(rec);
+
+	return rec.result;
+}
+
+int lp_trace_recorder::num_cols() const {
+
+	return lp->num_cols();
+}
+
+int lp_trace_recorder::num_rows() const {
+
+	return lp->num_rows();
+}
+
+col_status lp_trace_recorder::col_stat(int i) const {
+
+	return lp->col_stat(i);
+}
+
+double lp_trace_recorder::col_val(int i) const {
+
+	return lp->col_val(i);
+}
+
+double lp_trace_recorder::col_lb(int i) const {
+
+	return lp->col_lb(i);
+}
+
+double lp_trace_recorder::col_ub(int i) const {
+
+	return lp->col_ub(i);
+}
+
+double lp_trace_recorder::col_dual_val(int i) const {
+
+	return lp->col_dual_val(i);
+}
+
+double lp_trace_recorder::row_dual_val(int i) const {
+
+	return lp->row_dual_val(i);
+}
+
+bool lp_trace_recorder::infeasibility_certificate(vector<double>& y) const {
+
+	return lp->infeasibility_certificate(y);
+}
+
+bool lp_trace_recorder::has_reduced_costs() const {
+
+	return lp->has_reduced_costs();
+}
+
+double lp_trace_recorder::primal_tolerance() const {
+
+	return lp->primal_tolerance();
+}
+
+const sparse_rows* lp_trace_recorder::recorded_rows() const {
+
+	return lp->recorded_rows();
+}
+
+bool lp_trace_recorder::is_fixed(int index) const {
+
+	return lp->is_fixed(index);
+}
+
+void lp_trace_recorder::dump(const char* file) const {
+
+	lp->dump(file);
+}
+
+void lp_trace_recorder::show_iteration_count() const {
+
+	lp->show_iteration_count();
+}
+
+uint64_t lp_trace_recorder::iteration_count() const {
+
+	return lp->iteration_count();
+}
+
+void lp_trace_recorder::save_basis(lp_basis& basis) const {
+
+	lp->save_basis(basis);
+}
+
+void lp_trace_recorder::load_basis(const lp_basis& basis) {
+
+	lp->load_basis(basis);
+}
+
+lp_trace_replay::lp_trace_replay(const char* file) {
+
+	std::ifstream in(file, std::ios::binary);
+
+	char magic[MAGIC_SIZE];
+
+	in.read(magic, MAGIC_SIZE);
+
+	ASSERT2(in && std::memcmp(magic, MAGIC, MAGIC_SIZE)==0, "not an LP trace: "<<file);
+
+	trace_record rec;
+
+	while (read_value(in, rec.event)) {
+
+		bool success = read_value(in, rec.index);
+
+		success = success && read_value(in, rec.outcome);
+		success = success && read_value(in, rec.lb);
+		success = success && read_value(in, rec.ub);
+		success = success && read_value(in, rec.result);
+
+		if (success && rec.event == TRACE_ADD_ROW) {
+
+			rec.cols.assign(rec.index+1, 0);
+
+			rec.coeffs.assign(rec.index+1, 0.0);
+
+			in.read(reinterpret_cast<char*>(&rec.cols.at(1)),   rec.index*sizeof(int));
+
+			in.read(reinterpret_cast<char*>(&rec.coeffs.at(1)), rec.index*sizeof(double));
+
+			success = in.good();
+		}
+
+		ASSERT2(success, "truncated trace after "<<trace.size()<<" records");
+
+		trace.push_back(rec);
+	}
+}
+
+const lp_trace_replay::statistics lp_trace_replay::run(lp_impl* lp) const {
+
+	statistics stats = { 0, 0, 0, 0.0, 0.0 };
+
+	const double start = wall_time();
+
+	for (size_t i=0; i<trace.size(); ++i) {
+
+		replay(lp, trace.at(i), stats);
+	}
+
+	stats.seconds = wall_time() - start;
+
+	return stats;
+}
+
+void lp_trace_replay::replay(lp_impl* lp, const trace_record& rec, statistics& stats) const {
+
+	switch (rec.event) {
+
+	case TRACE_RESET: lp->reset(); return;
+
+	case TRACE_ADD_COLS: lp->add_cols(rec.index); return;
+
+	case TRACE_ADD_ROW: lp->add_eq_row(&rec.cols.at(0), &rec.coeffs.at(0), rec.index, rec.lb, rec.ub); return;
+
+	case TRACE_COL_BOUNDS: lp->set_col_bounds(rec.index, rec.lb, rec.ub); return;
+
+	case TRACE_RUN_SIMPLEX: case TRACE_TIGHTEN_LB: case TRACE_TIGHTEN_UB: break;
+
+	default: ASSERT2(false, "unknown trace event: "<<rec.event);
+	}
+
+	++stats.solves;
+
+	int outcome = TRACE_SOLVED;
+
+	double result = 0.0;
+
+	try {
+
+		if (rec.event == TRACE_RUN_SIMPLEX) {
+
+			lp->run_simplex();
+		}
+		else if (rec.event == TRACE_TIGHTEN_LB) {
+
+			result = lp->tighten_col_lb(rec.index, rec.lb);
+		}
+		else {
+
+			result = lp->tighten_col_ub(rec.index, rec.lb);
+		}
+	}
+	catch (infeasible_problem& ) {
+
+		outcome = TRACE_INFEASIBLE;
+	}
+	catch (numerical_problems& ) {
+
+		outcome = TRACE_NUMERICAL_PROBLEMS;
+	}
+
+	if (outcome != rec.outcome) {
+
+		++stats.outcome_mismatches;
+	}
+	else if (outcome == TRACE_SOLVED && rec.event != TRACE_RUN_SIMPLEX) {
+
+		const double discrepancy = std::fabs(result - rec.result);
+
+		if (discrepancy > stats.max_discrepancy) {
+
+			stats.max_discrepancy = discrepancy;
+		}
+
+		if (discrepancy > TOL_DISCREPANCY) {
+
+			++stats.bound_discrepancies;
+		}
+	}
+}
+
+}
@@ -20,11 +20,14 @@
 //
 //==============================================================================
 
+#include <cstdlib>
 #include <string>
 #include "assert_tests.hpp"
 #include "box_generator_tests.hpp"
+#include "dual_simplex_tests.hpp"
 #include "diagnostics.hpp"
 #include "examples.hpp"
+#include "threads.hpp"
 
 using std::string;
 using namespace asol;
@@ -36,6 +39,18 @@ const string SIMPLE_TESTS   = "simple_tests";
 const string SEARCH_PROC    = "search_procedure";
 const string INDEX_REC_TEST = "index_recorder";
 const string AA_EXPR_GRAPH  = "affine_expr_graph";
+const string GEN_KERNELS    = "generate_kernels";
+const string KERNEL_BENCH   = "kernel_benchmark";
+const string PARALLEL_PROC  = "parallel_search";
+const string SCALING_BENCH  = "scaling_benchmark";
+const string CONCURRENT     = "concurrent_search";
+const string LP_BENCH       = "lp_benchmark";
+const string LP_SCHEDULING  = "lp_scheduling";
+const string SEARCH_ORDER   = "search_order";
+const string LP_CAPTURE     = "lp_capture";
+const string LP_REPLAY      = "lp_replay";
+const string CHECKPOINTED   = "checkpointed_search";
+const string RESUME         = "--resume";
 
 }
 
@@ -45,9 +60,19 @@ void simple_tests() {
 
 	run_box_generator_test();
 
+	run_dual_simplex_test();
+
 	show_Jacobsen_sparsity();
 
 	run_examples();
+
+	run_newton_proof_test();
+
+	run_node_inheritance_test();
+
+	run_warm_start_test();
+
+	run_noise_term_limit_test();
 }
 
 void search_procedure() {
@@ -56,9 +81,20 @@ void search_procedure() {
 
 }
 
+void parallel_search(int argc, const char* argv[]) {
+
+	const int threads = (argc==3) ? std::atoi(argv[2]) : number_of_cores();
+
+	ASSERT2(threads > 0, "number of threads: "<<argv[2]);
+
+	run_parallel_search(threads);
+}
+
 int main(int argc, const char* argv[]) {
 
-	ASSERT2(argc==2,"provide command line arguments");
+	const bool has_file = argc>1 && (argv[1]==LP_CAPTURE || argv[1]==LP_REPLAY || argv[1]==CHECKPOINTED || argv[1]==RESUME);
+
+	ASSERT2((argc==2 && !has_file) || (argc==3 && (argv[1]==PARALLEL_PROC || has_file)),"provide command line arguments");
 
 	if (argv[1]==SIMPLE_TESTS) {
 
@@ -76,6 +112,54 @@ int main(int argc, const char* argv[]) {
 
 		affine_expression_graph_test();
 	}
+	else if (argv[1]==GEN_KERNELS) {
+
+		generate_kernels();
+	}
+	else if (argv[1]==KERNEL_BENCH) {
+
+		run_kernel_benchmark();
+	}
+	else if (argv[1]==PARALLEL_PROC) {
+
+		parallel_search(argc, argv);
+	}
+	else if (argv[1]==SCALING_BENCH) {
+
+		run_scaling_benchmark();
+	}
+	else if (argv[1]==CONCURRENT) {
+
+		run_concurrent_searches();
+	}
+	else if (argv[1]==LP_BENCH) {
+
+		run_lp_backend_benchmark();
+	}
+	else if (argv[1]==LP_SCHEDULING) {
+
+		run_scheduling_benchmark();
+	}
+	else if (argv[1]==SEARCH_ORDER) {
+
+		run_search_order_benchmark();
+	}
+	else if (argv[1]==LP_CAPTURE) {
+
+		run_lp_capture(argv[2]);
+	}
+	else if (argv[1]==LP_REPLAY) {
+
+		run_lp_replay(argv[2]);
+	}
+	else if (argv[1]==CHECKPOINTED) {
+
+		run_checkpointed_search(argv[2]);
+	}
+	else if (argv[1]==RESUME) {
+
+		run_resumed_search(argv[2]);
+	}
 	else {
 
 		ASSERT2(false,"command line argument not recognized: "<<argv[1]);
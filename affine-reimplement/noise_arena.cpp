@@ -0,0 +1,168 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include "noise_arena.hpp"
+#include "diagnostics.hpp"
+#include "solver_context.hpp"
+
+namespace {
+
+const int CHUNK_SIZE = 4096; // epsilons
+
+}
+
+namespace asol {
+
+noise_arena::noise_arena() : chunk(0), top(0), mark_chunk(0), mark_top(0), gen(0) {
+
+}
+
+epsilon* noise_arena::allocate(int n) {
+
+	ASSERT2(n > 0, "n: "<<n);
+
+	const int n_chunks = static_cast<int> (chunks.size());
+
+	for ( ; chunk<n_chunks; ++chunk, top=0) {
+
+		if (top+n <= chunk_size.at(chunk)) {
+
+			epsilon* const block = chunks.at(chunk) + top;
+
+			top += n;
+
+			return block;
+		}
+	}
+
+	const int size = std::max(CHUNK_SIZE, n);
+
+	chunks.push_back(new epsilon[size]);
+
+	chunk_size.push_back(size);
+
+	chunk = n_chunks;
+
+	top = n;
+
+	return chunks.back();
+}
+
+void noise_arena::set_mark() {
+
+	mark_chunk = chunk;
+
+	mark_top = top;
+}
+
+void noise_arena::rewind() {
+
+	chunk = mark_chunk;
+
+	top = mark_top;
+
+	++gen;
+}
+
+noise_arena::~noise_arena() {
+
+	for (size_t i=0; i<chunks.size(); ++i) {
+
+		delete[] chunks.at(i);
+	}
+}
+
+noise_terms::noise_terms(const noise_terms& other) : data(0), length(0), capacity(0), generation(STALE) {
+
+	*this = other;
+}
+
+noise_terms& noise_terms::operator=(const noise_terms& other) {
+
+	if (this != &other) {
+
+		clear();
+
+		reserve(other.length);
+
+		std::copy(other.begin(), other.end(), data);
+
+		length = other.length;
+	}
+
+	return *this;
+}
+
+bool noise_terms::owns_storage() const {
+
+	return generation==INLINE || generation==solver_context::current().noise.generation();
+}
+
+void noise_terms::clear() {
+
+	length = 0;
+
+	if (!owns_storage()) {
+
+		capacity = 0;
+	}
+}
+
+void noise_terms::reserve(int n) {
+
+	if (n > capacity || !owns_storage()) {
+
+		grow(n);
+	}
+}
+
+void noise_terms::grow(int n) {
+
+	if (n == 0) {
+
+		return;
+	}
+
+	noise_arena& arena = solver_context::current().noise;
+
+	const int size = std::max(n, 2*capacity);
+
+	epsilon* const block = arena.allocate(size);
+
+	std::copy(data, data+length, block);
+
+	data = block;
+
+	capacity = size;
+
+	generation = arena.generation();
+}
+
+#ifdef ASOL_ENABLE_ASSERTS
+void noise_terms::check_index(int i) const {
+
+	ASSERT2(0<=i && i<length, "index, size: "<<i<<", "<<length);
+}
+#endif
+
+}
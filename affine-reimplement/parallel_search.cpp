@@ -0,0 +1,196 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <iostream>
+#include "parallel_search.hpp"
+#include "box_pool.hpp"
+#include "box_scheduler.hpp"
+#include "builder.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+#include "problem.hpp"
+#include "problem_data.hpp"
+#include "sol_tracker.hpp"
+#include "threads.hpp"
+
+using std::cout;
+using std::endl;
+
+namespace {
+
+class worker_task : public asol::runnable {
+
+public:
+
+	explicit worker_task(asol::search_procedure* worker) : worker(worker) { }
+
+	virtual void run() { worker->run_worker(); }
+
+private:
+
+	asol::search_procedure* const worker;
+};
+
+}
+
+namespace asol {
+
+parallel_search::parallel_search(const problem<builder>* prob, int number_of_threads, lp_backend backend)
+: n_threads(number_of_threads),
+  scheduler(new box_scheduler(number_of_threads, prob->number_of_variables()))
+{
+	ASSERT2(n_threads > 0, "threads: "<<n_threads);
+
+	const context_scope scope(context);
+
+	builder::reset();
+
+	builder* x = prob->initial_box();
+
+	prob->evaluate(x);
+
+	delete[] x;
+
+	builder::finished();
+
+	const problem_data* const representation = builder::get_problem_data();
+
+	ASSERT(representation->number_of_variables() == prob->number_of_variables());
+
+	const DoubleArray2D solutions(prob->solutions());
+
+	// The workers are built here, their threads only bind the statics
+	for (int i=0; i<n_threads; ++i) {
+
+		workers.push_back(new search_procedure(representation, solutions, scheduler, i, backend));
+	}
+
+	push_initial_box(representation);
+
+	delete prob;
+
+	builder::reset();
+
+	total.solutions_found = total.splits = total.boxes_processed = total.solutions_proved = 0;
+}
+
+parallel_search::~parallel_search() {
+
+	for (int i=0; i<n_threads; ++i) {
+
+		delete workers.at(i);
+	}
+
+	delete scheduler;
+}
+
+void parallel_search::push_initial_box(const problem_data* representation) {
+
+	const BoundVector& initial_box = representation->get_initial_box();
+
+	const int n_vars = static_cast<int>(initial_box.size());
+
+	interval* x = scheduler->boxes()->allocate();
+
+	for (int i=0; i<n_vars; ++i) {
+
+		x[i] = interval(initial_box.at(i).first, initial_box.at(i).second);
+	}
+
+	scheduler->push(0, x);
+}
+
+void parallel_search::run() {
+
+	std::vector<runnable*> tasks;
+
+	for (int i=0; i<n_threads; ++i) {
+
+		tasks.push_back(new worker_task(workers.at(i)));
+	}
+
+	run_in_parallel(tasks);
+
+	for (int i=0; i<n_threads; ++i) {
+
+		delete tasks.at(i);
+	}
+
+	merge_statistics();
+
+	print_statistics();
+}
+
+void parallel_search::merge_statistics() {
+
+	total.solutions_found = total.splits = total.boxes_processed = total.solutions_proved = 0;
+
+	for (int i=0; i<n_threads; ++i) {
+
+		const search_procedure::statistics stats = workers.at(i)->get_statistics();
+
+		total.solutions_found += stats.solutions_found;
+
+		total.splits += stats.splits;
+
+		total.boxes_processed += stats.boxes_processed;
+
+		total.solutions_proved += stats.solutions_proved;
+	}
+
+	ASSERT(2*total.splits+1 == total.boxes_processed);
+}
+
+int parallel_search::steals() const {
+
+	return scheduler->steals();
+}
+
+void parallel_search::print_statistics() const {
+
+	cout << endl;
+	cout << "=========================================================" << endl;
+	cout << "Threads: " << n_threads << ", steals: " << steals() << endl;
+	cout << "Number of splits: " << total.splits << ", solutions: ";
+	cout << total.solutions_found << endl;
+	cout << "Peak boxes: " << scheduler->boxes()->peak_boxes() << ", box memory: ";
+	cout << scheduler->boxes()->memory() << " bytes" << endl;
+
+	std::vector<int> found;
+
+	for (int i=0; i<n_threads; ++i) {
+
+		const std::vector<int>& counters = workers.at(i)->found_solution_counters();
+
+		found.resize(std::max(found.size(), counters.size()), 0);
+
+		for (size_t k=0; k<counters.size(); ++k) {
+
+			found.at(k) += counters.at(k);
+		}
+	}
+
+	sol_tracker::print_counters(found); // each worker counts in its own context
+}
+
+}
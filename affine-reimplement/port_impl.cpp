@@ -25,6 +25,8 @@
 #include "port_impl.hpp"
 #include "diagnostics.hpp"
 #include "exceptions.hpp"
+#include "thread_local.hpp"
+#include "threads.hpp"
 
 extern "C" {
 
@@ -38,7 +40,9 @@ void cprint_(double* A, int* M, int* N, int* IA, double* B, double* C, double* X
 
 namespace {
 
-int itr_count = 0; // callback function cprint_ updates this at each iteration
+ASOL_THREAD_LOCAL int itr_count = 0; // callback function cprint_ updates this at each iteration
+
+asol::mutex port_lock; // the PORT library keeps its work space in a common block
 }
 
 namespace asol {
@@ -54,6 +58,25 @@ port_impl::~port_impl() {
 
 }
 
+// The whole data chunk is copied, X included
+port_impl::port_impl(const port_impl& other) :
+	lp_impl(),
+	A(other.A), M(other.M), N(other.N), IA(other.IA),
+	B(other.B), C(other.C), X(other.X),
+	MAXITR(other.MAXITR), CTX(other.CTX),
+	SIMP(other.SIMP), ISIMP(other.ISIMP),
+	IE(other.IE), IERR(other.IERR),
+	rows_added(other.rows_added), slacks_added(other.slacks_added),
+	sum_itr_count(other.sum_itr_count)
+{
+
+}
+
+lp_impl* port_impl::clone() const {
+
+	return new port_impl(*this);
+}
+
 void port_impl::init() {
 
 	M  = 0;
@@ -71,13 +94,27 @@ void port_impl::init() {
 	slacks_added = 0;
 }
 
+// X is kept as the initial estimate of the next LP
 void port_impl::reset() {
 
 	sum_itr_count += itr_count;
 
 	itr_count = 0;
 
-	init();
+	rows_added   = 0;
+	slacks_added = 0;
+
+	std::fill(A.begin(), A.end(), 0.0);
+	std::fill(B.begin(), B.end(), 0.0);
+	std::fill(C.begin(), C.end(), 0.0);
+
+	std::fill(SIMP.begin(),  SIMP.end(),  0.0);
+	std::fill(ISIMP.begin(), ISIMP.end(), 0);
+
+	for (int i=0; i<M; ++i) {
+
+		set_simple_bounds(i, -1, 1);
+	}
 }
 
 void port_impl::add_cols(int n) {
@@ -205,6 +242,8 @@ void port_impl::call_solver() {
 	ASSERT(rows_added>=slacks_added);
 	ASSERT(IS<=SIMP.size());
 
+	scoped_lock lock(port_lock);
+
 	linpas_(&A.at(0), &M, &N, &IA, &B.at(0), &C.at(0), &X.at(0),
 			&MAXITR, &CTX, &IS, &SIMP.at(0), &ISIMP.at(0), &IE, &ERRCOD);
 
@@ -294,6 +333,31 @@ double port_impl::col_dual_val(int i) const {
 	ASSERT(false);
 }
 
+double port_impl::row_dual_val(int i) const {
+
+	ASSERT(false);
+}
+
+bool port_impl::infeasibility_certificate(std::vector<double>& ) const {
+
+	return false;
+}
+
+bool port_impl::has_reduced_costs() const {
+
+	return false;
+}
+
+double port_impl::primal_tolerance() const {
+
+	return 0.0;
+}
+
+const sparse_rows* port_impl::recorded_rows() const {
+
+	return 0;
+}
+
 bool port_impl::is_fixed(int index) const {
 
 	ASSERT(false);
@@ -304,11 +368,29 @@ void port_impl::dump(const char* file) const {
 	ASSERT(false);
 }
 
+void port_impl::save_basis(lp_basis& basis) const {
+
+	basis.status.clear();
+
+	basis.point = X;
+}
+
+void port_impl::load_basis(const lp_basis& basis) {
+
+	if (basis.point.size() == X.size()) {
+
+		X = basis.point;
+	}
+}
+
 void port_impl::show_iteration_count() const {
 
-	uint64_t count = sum_itr_count + itr_count;
+	std::cout << "Simplex iterations: " << iteration_count() << std::endl;
+}
+
+uint64_t port_impl::iteration_count() const {
 
-	std::cout << "Simplex iterations: " << count << std::endl;
+	return sum_itr_count + itr_count;
 }
 
 }
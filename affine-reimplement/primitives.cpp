@@ -28,21 +28,17 @@
 
 namespace asol {
 
-template <typename T>
-std::vector<T>* primitive<T>::v = 0;
-
-template <typename T>
-std::vector<gap_info<T> >* primitive<T>::gaps = 0;
-
 template <typename T>
 void primitive<T>::set_vector(std::vector<T>* vec) {
 
-	v = vec;
+	solver_context::current().nodes<T>().v = vec;
 }
 
 template <typename T>
 void primitive<T>::set_gap_container(std::vector<gap_info<T> >* vec) {
 
+	std::vector<gap_info<T> >*& gaps = solver_context::current().nodes<T>().gaps;
+
 	ASSERT2(vec==0 || gaps==0,"forgot to set gap container to NULL");
 	gaps = vec;
 }
@@ -56,6 +52,8 @@ primitive<T>::~primitive() { }
 template <typename T>
 void primitive<T>::push_back(int index, const T& value) const {
 
+	std::vector<gap_info<T> >* const gaps = solver_context::current().nodes<T>().gaps;
+
 	if (gaps) {
 
 		gaps->push_back(gap_info<T>(index, value));
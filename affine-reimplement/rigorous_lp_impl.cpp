@@ -0,0 +1,302 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include "rigorous_lp_impl.hpp"
+#include "rounding_mode.hpp"
+
+using std::vector;
+
+namespace asol {
+
+rigorous_lp_impl::rigorous_lp_impl(lp_impl* solver) : lp(solver) {
+
+}
+
+rigorous_lp_impl::rigorous_lp_impl(const rigorous_lp_impl& other)
+: lp_impl(),
+  lp(other.lp->clone()),
+  rows(other.rows),
+  reduced_costs(other.reduced_costs)
+{
+
+}
+
+rigorous_lp_impl::~rigorous_lp_impl() {
+
+	delete lp;
+}
+
+lp_impl* rigorous_lp_impl::clone() const {
+
+	return new rigorous_lp_impl(*this);
+}
+
+void rigorous_lp_impl::reset() {
+
+	lp->reset();
+
+	rows.clear();
+
+	forget_reduced_costs();
+}
+
+void rigorous_lp_impl::add_cols(int n) {
+
+	lp->add_cols(n);
+}
+
+void rigorous_lp_impl::add_eq_row(const int index[], const double value[], int length, double lb, double ub) {
+
+	lp->add_eq_row(index, value, length, lb, ub);
+
+	rows.add(index, value, length, lb, ub);
+}
+
+void rigorous_lp_impl::set_col_bounds(int index, double lb, double ub) {
+
+	lp->set_col_bounds(index, lb, ub);
+}
+
+void rigorous_lp_impl::run_simplex() {
+
+	forget_reduced_costs();
+
+	lp->run_simplex();
+}
+
+// The reduced costs are kept only if the bound comes from the same duals
+double rigorous_lp_impl::tighten_col_lb(int i, const double lb) {
+
+	lp->tighten_col_lb(i, lb);
+
+	const double safe_lb = safe_lower_bound(i, 1.0);
+
+	if (safe_lb > lb) {
+
+		return safe_lb;
+	}
+
+	forget_reduced_costs();
+
+	return lb;
+}
+
+double rigorous_lp_impl::tighten_col_ub(int i, const double ub) {
+
+	lp->tighten_col_ub(i, ub);
+
+	const double safe_ub = -safe_lower_bound(i, -1.0);
+
+	if (safe_ub < ub) {
+
+		return safe_ub;
+	}
+
+	forget_reduced_costs();
+
+	return ub;
+}
+
+void rigorous_lp_impl::forget_reduced_costs() {
+
+	reduced_costs.assign(reduced_costs.size(), 0.0);
+}
+
+// Lower bound on sign*x_i over the LP, using the duals of the last solve.
+// With y the row duals times sign and c = sign*e_i, the residual
+// c - A^T y is enclosed in [-t_up, -t_lo] where t = A^T y - c, then
+// sign*x_i >= inf(y^T [row_lb, row_ub]) + inf((c - A^T y)^T [col_lb, col_ub]).
+// The enclosures of c - A^T y are saved as the reduced costs.
+double rigorous_lp_impl::safe_lower_bound(int i, double sign) {
+
+	const int m = rows.size();
+
+	const int n = lp->num_cols();
+
+	vector<double> y(m);
+
+	for (int k=0; k<m; ++k) {
+
+		y.at(k) = sign*lp->row_dual_val(k+1);
+	}
+
+	vector<double> t_lo(n+1, 0.0), t_up(n+1, 0.0);
+
+	t_lo.at(i) = t_up.at(i) = -sign;
+
+	rounding_mode mode(rounding_mode::DOWNWARD);
+
+	for (int k=0; k<m; ++k) {
+
+		for (int p=rows.start.at(k); p<rows.start.at(k+1); ++p) {
+
+			t_lo.at(rows.index.at(p)) += rows.coeff.at(p)*y.at(k);
+		}
+	}
+
+	mode.set(rounding_mode::UPWARD);
+
+	for (int k=0; k<m; ++k) {
+
+		for (int p=rows.start.at(k); p<rows.start.at(k+1); ++p) {
+
+			t_up.at(rows.index.at(p)) += rows.coeff.at(p)*y.at(k);
+		}
+	}
+
+	reduced_costs.assign(n+1, 0.0);
+
+	for (int j=1; j<=n; ++j) {
+
+		const double r_lo = -t_up.at(j);
+
+		const double r_up = -t_lo.at(j);
+
+		const double r = (r_lo > 0.0) ? r_lo : (r_up < 0.0) ? r_up : 0.0;
+
+		reduced_costs.at(j) = sign*r;
+	}
+
+	mode.set(rounding_mode::DOWNWARD);
+
+	double z = 0.0;
+
+	for (int k=0; k<m; ++k) {
+
+		const double y_k = y.at(k);
+
+		z += y_k*((y_k >= 0.0) ? rows.lb.at(k) : rows.ub.at(k));
+	}
+
+	for (int j=1; j<=n; ++j) {
+
+		const double l = lp->col_lb(j);
+
+		const double u = lp->col_ub(j);
+
+		const double r_lo = -t_up.at(j);
+
+		const double r_up = -t_lo.at(j);
+
+		z += std::min(std::min(r_lo*l, r_lo*u), std::min(r_up*l, r_up*u));
+	}
+
+	return z;
+}
+
+int rigorous_lp_impl::num_cols() const {
+
+	return lp->num_cols();
+}
+
+int rigorous_lp_impl::num_rows() const {
+
+	return lp->num_rows();
+}
+
+col_status rigorous_lp_impl::col_stat(int i) const {
+
+	return lp->col_stat(i);
+}
+
+double rigorous_lp_impl::col_val(int i) const {
+
+	return lp->col_val(i);
+}
+
+double rigorous_lp_impl::col_lb(int i) const {
+
+	return lp->col_lb(i);
+}
+
+double rigorous_lp_impl::col_ub(int i) const {
+
+	return lp->col_ub(i);
+}
+
+// The endpoint of the enclosure closer to zero, 0 if the sign is uncertain
+// or the last bound did not improve: with L the verified bound of x_i and
+// r_j in the enclosure, x_i >= L + r_j*(x_j - col_lb(j)) holds for every
+// feasible point if r_j > 0, and similarly with col_ub(j) if r_j < 0. So
+// the bounds derived in lp_pruning from these and from L are safe.
+double rigorous_lp_impl::col_dual_val(int i) const {
+
+	return (static_cast<size_t>(i) < reduced_costs.size()) ? reduced_costs.at(i) : 0.0;
+}
+
+double rigorous_lp_impl::row_dual_val(int i) const {
+
+	return lp->row_dual_val(i);
+}
+
+bool rigorous_lp_impl::infeasibility_certificate(vector<double>& y) const {
+
+	return lp->infeasibility_certificate(y);
+}
+
+bool rigorous_lp_impl::has_reduced_costs() const {
+
+	return lp->has_reduced_costs();
+}
+
+double rigorous_lp_impl::primal_tolerance() const {
+
+	return lp->primal_tolerance();
+}
+
+const sparse_rows* rigorous_lp_impl::recorded_rows() const {
+
+	return &rows;
+}
+
+bool rigorous_lp_impl::is_fixed(int index) const {
+
+	return lp->is_fixed(index);
+}
+
+void rigorous_lp_impl::dump(const char* file) const {
+
+	lp->dump(file);
+}
+
+void rigorous_lp_impl::show_iteration_count() const {
+
+	lp->show_iteration_count();
+}
+
+uint64_t rigorous_lp_impl::iteration_count() const {
+
+	return lp->iteration_count();
+}
+
+void rigorous_lp_impl::save_basis(lp_basis& basis) const {
+
+	lp->save_basis(basis);
+}
+
+void rigorous_lp_impl::load_basis(const lp_basis& basis) {
+
+	lp->load_basis(basis);
+}
+
+}
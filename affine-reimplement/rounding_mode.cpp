@@ -20,78 +20,27 @@
 //
 //==============================================================================
 
-#include <limits>
-#include "affine_pair_iterator.hpp"
+#include <fenv.h>
+#include "rounding_mode.hpp"
 #include "diagnostics.hpp"
 
 namespace asol {
 
+rounding_mode::rounding_mode(direction dir) {
 
-affine_pair_iterator::affine_pair_iterator(const affine& x, const affine& y) :
-	i    (x.noise_vars.begin()),
-	i_end(x.noise_vars.end()),
-	j    (y.noise_vars.begin()),
-	j_end(y.noise_vars.end())
-{
-	x.dbg_consistency();
-	y.dbg_consistency();
-
-	k = i->index; // k = 0;
-
-	x_k = i->coeff;
-	y_k = j->coeff;
-
-	++i;
-	++j;
+	set(dir);
 }
 
-bool affine_pair_iterator::increment() {
-
-	if (i == i_end && j == j_end) {
-
-		return false;
-	}
-
-	const int int_max = std::numeric_limits<int>::max();
-
-    const int i_index = (i != i_end) ? i->index : int_max;
-
-    const int j_index = (j != j_end) ? j->index : int_max;
-
-	if (i_index < j_index) {
+void rounding_mode::set(direction dir) {
 
-		k = i_index;
+	const int error = fesetround((dir == DOWNWARD) ? FE_DOWNWARD : FE_UPWARD);
 
-		x_k = i->coeff;
-		y_k = 0.0;
-
-		++i;
-	}
-	else if (j_index < i_index ) {
-
-		k = j_index;
-
-		x_k = 0.0;
-		y_k = j->coeff;
-
-		++j;
-	}
-	else {
-
-		ASSERT(i_index!=int_max && i_index==j_index);
-
-		k = i_index;
-
-		x_k = i->coeff;
-		y_k = j->coeff;
-
-		++i;
-		++j;
-	}
+	ASSERT2(error==0, "failed to change the rounding mode");
+}
 
-	ASSERT(k > 0);
+rounding_mode::~rounding_mode() {
 
-	return true;
+	fesetround(FE_TONEAREST);
 }
 
 }
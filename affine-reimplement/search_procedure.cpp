@@ -24,43 +24,110 @@
 #include <cmath>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <sys/time.h>
+#include <typeinfo>
 #include "search_procedure.hpp"
 #include "affine.hpp"
+#include "box_pool.hpp"
+#include "box_scheduler.hpp"
 #include "builder.hpp"
+#include "checkpoint.hpp"
+#include "demangle.hpp"
 #include "diagnostics.hpp"
 #include "exceptions.hpp"
 #include "expression_graph.hpp"
 #include "index_recorder.hpp"
 #include "splitting_strategy.hpp"
+#include "split_tree.hpp"
 #include "interval.hpp"
+#include "interval_ad.hpp"
+#include "interval_batch.hpp"
+#include "interval_newton.hpp"
 #include "lp_solver.hpp"
 #include "problem.hpp"
 #include "problem_data.hpp"
+#include "sol_tracker.hpp"
 #include "vector_dump.hpp"
 
 using std::cout;
 using std::endl;
 using std::fabs;
 
+namespace {
+
+const int BATCH_LANES = 16; // boxes contracted together by interval_batch
+
+const int MAX_NEWTON_STEPS = 8;
+
+const double NEWTON_REPEAT_RATIO = 0.9; // of the best new and old diameter
+
+const double CONVERGENCE_TOL = 0.05; // FIXME Just for testing
+
+double wall_time() {
+
+	timeval t;
+
+	gettimeofday(&t, 0);
+
+	return t.tv_sec + t.tv_usec*1.0e-6;
+}
+
+}
+
 namespace asol {
 
-search_procedure::search_procedure(const problem<builder>* p)
+namespace {
+
+const void* key_of(const interval* box, const split_node* node) {
+
+	return node ? static_cast<const void*>(node) : box;
+}
+
+}
+
+search_procedure::search_procedure(const problem<builder>* p, lp_backend backend)
 : prob(p),
   //split_strategy(new max_diam_selector(prob->number_of_variables())),
   split_strategy(new Jacobsen_x1_D(prob->number_of_variables())),
   //split_strategy(new eco9_sparsity(prob->number_of_variables())),
   n_vars(prob->number_of_variables()),
   representation(0),
-  lp(new lp_solver),
-  box_orig(0)
+  lp(new lp_solver(backend)),
+  pending_boxes(box_queue<interval>::new_queue(order, n_vars)),
+  pending_nodes(0),
+  tree(0),
+  scheduler(0),
+  pool(new box_pool(n_vars)),
+  worker_id(0),
+  has_inherited(false),
+  inherit_enclosures(false),
+  warm_start_lp(true),
+  schedule(new contractor_scheduler(scheduling_options())),
+  depth(0),
+  unique_solution_proved(false),
+  box_orig(0),
+  node_orig(0),
+  checkpoint_period(0.0),
+  last_checkpoint(0.0)
 {
+	const context_scope scope(context);
+
 	build_problem_representation();
 
-	init_dags();
+	init_dags(prob->solutions());
+
+	push_initial_box_to_deque();
+	//dbg_initial_box_from_dump();
 
 	init_lp_solver();
 
-	solutions_found = splits = boxes_processed = 0;
+	solutions_found = splits = boxes_processed = solutions_proved = 0;
+
+	splits_to_first_solution = -1;
+
+	convergence_tol = CONVERGENCE_TOL;
 
 	representation = 0;
 
@@ -71,16 +138,79 @@ search_procedure::search_procedure(const problem<builder>* p)
 	builder::reset();
 }
 
+search_procedure::search_procedure(const problem_data* problem,
+                                   const DoubleArray2D& solutions,
+                                   box_scheduler* box_source,
+                                   int id,
+                                   lp_backend backend)
+: prob(0),
+  split_strategy(new Jacobsen_x1_D(problem->number_of_variables())),
+  n_vars(problem->number_of_variables()),
+  representation(problem),
+  lp(new lp_solver(backend)),
+  pending_boxes(box_queue<interval>::new_queue(order, n_vars)),
+  pending_nodes(0),
+  tree(0),
+  scheduler(box_source),
+  pool(box_source->boxes()),
+  worker_id(id),
+  has_inherited(false),
+  inherit_enclosures(false),
+  warm_start_lp(true),
+  schedule(new contractor_scheduler(scheduling_options())),
+  depth(0),
+  unique_solution_proved(false),
+  box_orig(0),
+  node_orig(0),
+  checkpoint_period(0.0),
+  last_checkpoint(0.0)
+{
+	const context_scope scope(context);
+
+	init_dags(solutions);
+
+	init_lp_solver();
+
+	solutions_found = splits = boxes_processed = solutions_proved = 0;
+
+	splits_to_first_solution = -1;
+
+	convergence_tol = CONVERGENCE_TOL;
+
+	representation = 0;
+}
+
 search_procedure::~search_procedure() {
 
 	delete ia_dag;
 
 	delete aa_dag;
 
+	delete ia_batch;
+
+	delete newton;
+
+	delete residual_ad;
+
+	release_nodes();
+
+	delete pending_nodes;
+
+	delete tree;
+
+	delete pending_boxes;
+
 	delete lp;
 
+	delete schedule;
+
 	delete split_strategy;
 
+	if (!scheduler) {
+
+		delete pool;
+	}
+
 	lp_solver::free_environment();
 }
 
@@ -106,18 +236,21 @@ void search_procedure::evaluate_with_builder() const {
 	builder::finished();
 }
 
-void search_procedure::init_dags() {
+void search_procedure::init_dags(const DoubleArray2D& solutions) {
 
 	//const IntArray2D index_set = index_sets();
 
-	ia_dag = new expression_graph<interval>(representation, prob->solutions());
-
-	push_initial_box_to_deque();
-	//dbg_initial_box_from_dump();
+	ia_dag = new expression_graph<interval>(representation, solutions);
 
 	affine::set_vector(ia_dag->get_v());
 
 	aa_dag = new expression_graph<affine>(representation);
+
+	ia_batch = new interval_batch(representation, BATCH_LANES);
+
+	newton = new interval_newton(representation);
+
+	residual_ad = new interval_ad(representation);
 }
 
 void search_procedure::init_lp_solver() {
@@ -143,15 +276,15 @@ struct pair2interval {
 
 void search_procedure::push_initial_box_to_deque() {
 
-	ASSERT(pending_boxes.empty());
+	ASSERT(pending_size() == 0);
 
 	const BoundVector& initial_box = representation->get_initial_box();
 
-	interval* x = new interval[n_vars];
+	interval* x = pool->allocate();
 
 	std::transform(initial_box.begin(), initial_box.end(), x, pair2interval());
 
-	pending_boxes.push_back(x);
+	push_box(x);
 }
 
 std::vector<std::vector<int> > search_procedure::index_sets() const {
@@ -176,23 +309,37 @@ std::vector<std::vector<int> > search_procedure::index_sets() const {
 
 void search_procedure::dbg_initial_box_from_dump() {
 
-	ASSERT(pending_boxes.empty());
+	ASSERT(pending_size() == 0);
 
 	std::vector<interval> v;
 
 	load(v);
 
-	interval* x = new interval[n_vars];
+	interval* x = pool->allocate();
 
 	std::copy(&v.at(0), &v.at(n_vars), x);
 
-	pending_boxes.push_back(x);
+	push_box(x);
 }
 
 void search_procedure::run() {
 
+	const context_scope scope(context);
+
 	while (has_more_boxes()) {
 
+		if (needs_screening()) {
+
+			if (checkpoint_due()) {
+
+				save_checkpoint();
+			}
+
+			screen_pending_boxes();
+
+			continue;
+		}
+
 		get_next_box();
 
 		process_box();
@@ -205,9 +352,421 @@ void search_procedure::run() {
 	print_statistics();
 }
 
+void search_procedure::run_worker() {
+
+	ASSERT(scheduler != 0);
+
+	const context_scope scope(context);
+
+	while ((box_orig = scheduler->pop(worker_id)) != 0) {
+
+		process_box();
+
+		ia_dag->show_variables(cout);
+
+		split_if_not_discarded();
+
+		scheduler->box_done();
+	}
+}
+
+void search_procedure::capture_lp_trace(const char* file) {
+
+	lp->capture_trace(file);
+}
+
+void search_procedure::set_scheduling(const scheduling_options& options) {
+
+	delete schedule;
+
+	schedule = new contractor_scheduler(options);
+}
+
+void search_procedure::set_node_inheritance(bool on) {
+
+	inherit_enclosures = on;
+}
+
+void search_procedure::set_warm_start(bool on) {
+
+	warm_start_lp = on;
+}
+
+void search_procedure::set_pruning_threads(int n) {
+
+	lp->set_pruning_threads(n);
+}
+
+void search_procedure::set_initial_box(const std::vector<interval>& box) {
+
+	ASSERT2(static_cast<int>(box.size()) == n_vars, "size: "<<box.size());
+
+	ASSERT(pending_size() == 1 && screened_boxes.empty() && splits == 0);
+
+	const split_node* node = 0;
+
+	interval* x = pop_pending_box(node);
+
+	if (node) {
+
+		tree->release(node);
+	}
+
+	std::copy(box.begin(), box.end(), x);
+
+	push_box(x);
+}
+
+void search_procedure::set_convergence_tolerance(double tol) {
+
+	ASSERT2(tol > 0.0, "tolerance: "<<tol);
+
+	convergence_tol = tol;
+}
+
+void search_procedure::set_search_order(const search_options& options) {
+
+	ASSERT(screened_boxes.empty() && depths.empty() && warm_starts.empty() && enclosures.empty());
+
+	const bool ordered = options.order == BREADTH_FIRST || options.order == DEPTH_FIRST;
+
+	ASSERT2(options.ram_budget == 0 || (ordered && !options.compact_frontier),
+	        "the frontier is spilled in breadth-first or depth-first order only, without compact frontier");
+
+	std::vector<interval*> boxes; // only the initial box is pending before run()
+
+	while (pending_size() > 0) {
+
+		const split_node* node = 0;
+
+		boxes.push_back(pop_pending_box(node));
+
+		if (node) {
+
+			tree->release(node);
+		}
+	}
+
+	delete pending_boxes;
+
+	delete pending_nodes;
+
+	delete tree;
+
+	order = options;
+
+	const bool compact = order.compact_frontier;
+
+	const bool spilling = !compact && ordered && order.ram_budget > 0; // if the asserts are off
+
+	pending_boxes = compact ? 0 : spilling ? new spilling_queue(order, n_vars, pool, this)
+	                                       : box_queue<interval>::new_queue(order, n_vars);
+
+	pending_nodes = compact ? box_queue<const split_node>::new_queue(order, n_vars) : 0;
+
+	tree = compact ? new split_tree(n_vars) : 0;
+
+	for (size_t i=0; i<boxes.size(); ++i) {
+
+		push_box(boxes.at(i));
+	}
+}
+
+void search_procedure::set_checkpoint(const char* file, double period) {
+
+	ASSERT(scheduler == 0);
+
+	checkpoint_file = file;
+
+	checkpoint_period = period;
+
+	last_checkpoint = wall_time();
+}
+
+namespace {
+
+// Materializes the nodes of a compact frontier; the depth is taken from
+// the tag of a spilled box, or from the depths of the pending boxes
+class frontier_writer : public box_queue<interval>::visitor,
+                        public box_queue<const split_node>::visitor {
+
+public:
+
+	frontier_writer(checkpoint_writer& out, const std::map<const void*, int>& depths, split_tree* tree, int n_vars)
+	: out(out), depths(depths), tree(tree), scratch(n_vars)
+	{
+
+	}
+
+	virtual void visit(const interval* box, int tag) {
+
+		out.add_box(box, tag >= 0 ? tag : depth(box));
+	}
+
+	virtual void visit(const split_node* node, int ) {
+
+		tree->materialize(node, &scratch.at(0));
+
+		out.add_box(&scratch.at(0), depth(node));
+	}
+
+private:
+
+	int depth(const void* key) const {
+
+		std::map<const void*, int>::const_iterator itr = depths.find(key);
+
+		return (itr != depths.end()) ? itr->second : 0;
+	}
+
+	checkpoint_writer& out;
+
+	const std::map<const void*, int>& depths;
+
+	split_tree* const tree;
+
+	std::vector<interval> scratch;
+};
+
+}
+
+bool search_procedure::checkpoint_due() const {
+
+	return !checkpoint_file.empty() && wall_time() - last_checkpoint >= checkpoint_period;
+}
+
+// Called between two boxes, when the screened boxes are all processed
+void search_procedure::save_checkpoint() {
+
+	ASSERT(screened_boxes.empty() && box_orig == 0);
+
+	checkpoint_header header;
+
+	header.n_vars = n_vars;
+	header.strategy = name(typeid(*split_strategy));
+	header.solutions_found = solutions_found;
+	header.splits = splits;
+	header.boxes_processed = boxes_processed;
+	header.splits_to_first_solution = splits_to_first_solution;
+	header.solutions_proved = solutions_proved;
+	header.found_counters = context.found_solutions;
+	header.solutions = solution_boxes;
+	header.pending_boxes = pending_size();
+
+	checkpoint_writer out(checkpoint_file.c_str(), header);
+
+	frontier_writer writer(out, depths, tree, n_vars);
+
+	if (tree) {
+
+		pending_nodes->visit_all(writer);
+	}
+	else {
+
+		pending_boxes->visit_all(writer);
+	}
+
+	out.commit();
+
+	last_checkpoint = wall_time();
+
+	cout << "Checkpoint written, pending boxes: " << header.pending_boxes << endl;
+}
+
+void search_procedure::resume(const char* file) {
+
+	ASSERT(scheduler == 0 && screened_boxes.empty() && box_orig == 0);
+
+	checkpoint_reader in(file);
+
+	const checkpoint_header& header = in.header();
+
+	ASSERT2(header.n_vars == n_vars, "variables in the checkpoint: "<<header.n_vars);
+
+	ASSERT2(header.strategy == name(typeid(*split_strategy)), "splitting strategy: "<<header.strategy);
+
+	ASSERT2(header.pending_boxes == 2*header.splits+1-header.boxes_processed, "corrupt checkpoint: "<<file);
+
+	while (pending_size() > 0) { // the initial box
+
+		const split_node* node = 0;
+
+		pool->release(pop_pending_box(node));
+
+		if (node) {
+
+			tree->release(node);
+		}
+	}
+
+	solutions_found = header.solutions_found;
+	splits = header.splits;
+	boxes_processed = header.boxes_processed;
+	splits_to_first_solution = header.splits_to_first_solution;
+	solutions_proved = header.solutions_proved;
+
+	context.found_solutions = header.found_counters;
+
+	solution_boxes = header.solutions;
+
+	interval* box = pool->allocate();
+
+	int box_depth = 0;
+
+	while (in.next_box(box, box_depth)) {
+
+		const split_node* node = tree ? tree->add_root(box) : 0;
+
+		depths[key_of(box, node)] = box_depth;
+
+		push_box(box, node);
+
+		box = pool->allocate();
+	}
+
+	pool->release(box);
+
+	cout << "Resumed from " << file << ", pending boxes: " << header.pending_boxes << endl;
+}
+
+const search_procedure::statistics search_procedure::get_statistics() const {
+
+	statistics stats = { solutions_found, splits, boxes_processed, peak_frontier(), splits_to_first_solution, solutions_proved, lp->iteration_count() };
+
+	return stats;
+}
+
+const std::vector<int>& search_procedure::found_solution_counters() const {
+
+	return context.found_solutions;
+}
+
+void search_procedure::print_found_solutions() const {
+
+	sol_tracker::print_counters(context.found_solutions);
+}
+
 bool search_procedure::has_more_boxes() const {
 
-	return !pending_boxes.empty();
+	return pending_size() > 0 || !screened_boxes.empty();
+}
+
+int search_procedure::pending_size() const {
+
+	return tree ? pending_nodes->size() : pending_boxes->size();
+}
+
+int search_procedure::peak_frontier() const {
+
+	return tree ? pending_nodes->peak_size() : pending_boxes->peak_size();
+}
+
+// The box is materialized into a new slab if the frontier is compact, the
+// node is kept until the box is split or discarded
+interval* search_procedure::pop_pending_box(const split_node*& node) {
+
+	node = 0;
+
+	if (!tree) {
+
+		return pending_boxes->pop();
+	}
+
+	node = pending_nodes->pop();
+
+	interval* box = pool->allocate();
+
+	tree->materialize(node, box);
+
+	return box;
+}
+
+void search_procedure::release_nodes() {
+
+	if (!tree) {
+
+		return;
+	}
+
+	while (!pending_nodes->empty()) {
+
+		tree->release(pending_nodes->pop());
+	}
+
+	for (size_t i=0; i<screened_nodes.size(); ++i) {
+
+		tree->release(screened_nodes.at(i));
+	}
+
+	tree->release(node_orig);
+
+	screened_nodes.clear();
+
+	node_orig = 0;
+}
+
+bool search_procedure::needs_screening() const {
+
+	return screened_boxes.empty();
+}
+
+// Contracts the next boxes of the queue together, and discards those that
+// are proved to be infeasible
+void search_procedure::screen_pending_boxes() {
+
+	const int n = std::min(ia_batch->lanes(), pending_size());
+
+	std::vector<interval*> batch(n);
+
+	std::vector<const split_node*> nodes(n);
+
+	for (int i=0; i<ia_batch->lanes(); ++i) {
+
+		if (i < n) {
+			batch.at(i) = pop_pending_box(nodes.at(i));
+			ia_batch->set_box(i, batch.at(i));
+		}
+		else {
+			ia_batch->disable(i);
+		}
+	}
+
+	ia_batch->iterative_revision();
+
+	for (int i=0; i<n; ++i) {
+
+		interval* box = batch.at(i);
+
+		if (ia_batch->feasible(i)) {
+
+			ia_batch->get_box(i, box);
+
+			screened_boxes.push_back(box);
+
+			screened_nodes.push_back(nodes.at(i));
+		}
+		else {
+
+			cout << "Box discarded by batch revision" << endl;
+
+			const box_key key = key_of(box, nodes.at(i));
+
+			warm_starts.erase(key);
+
+			depths.erase(key);
+
+			enclosures.erase(key);
+
+			pool->release(box);
+
+			if (tree) {
+
+				tree->release(nodes.at(i));
+			}
+
+			++boxes_processed;
+		}
+	}
 }
 
 void search_procedure::get_next_box() {
@@ -216,9 +775,21 @@ void search_procedure::get_next_box() {
 
 	ASSERT(box_orig == 0);
 
-	box_orig = pending_boxes.front();
+	box_orig = screened_boxes.front();
+
+	screened_boxes.pop_front();
+
+	node_orig = screened_nodes.front();
+
+	screened_nodes.pop_front();
+
+	const box_key key = key_of(box_orig, node_orig);
 
-	pending_boxes.pop_front();
+	load_warm_start(key);
+
+	load_depth(key);
+
+	load_enclosures(key);
 }
 
 void search_procedure::print_statistics() const {
@@ -230,8 +801,20 @@ void search_procedure::print_statistics() const {
 	cout << "Number of splits: " << splits << ", solutions: ";
 	cout << solutions_found << endl;
 
+	cout << "Peak frontier: " << peak_frontier() << endl;
+
+	if (tree) {
+
+		cout << "Split tree peak memory: " << tree->peak_memory() << " bytes, as full boxes: ";
+		cout << peak_frontier()*n_vars*sizeof(interval) << " bytes" << endl;
+	}
+
+	cout << "Peak boxes: " << pool->peak_boxes() << ", box memory: " << pool->memory() << " bytes" << endl;
+	cout << "Constraint revisions: " << ia_dag->constraint_revisions() << endl;
+	cout << "Solutions proved unique by interval Newton: " << solutions_proved << endl;
 	lp->show_iteration_count();
-	ia_dag->print_found_solutions();
+	schedule->print_statistics();
+	print_found_solutions();
 }
 
 void search_procedure::process_box() {
@@ -307,27 +890,44 @@ void search_procedure::roll_back() {
 
 void search_procedure::contracting_step() {
 
-	ia_dag->set_box(box_orig, n_vars);
+	if (has_inherited) {
+
+		ia_dag->set_box(box_orig, n_vars, inherited);
+
+		has_inherited = false;
+	}
+	else {
+
+		ia_dag->set_box(box_orig, n_vars);
+	}
 
 	ia_dag->save_containment_info();
 	// TODO Check index sets!
 	//ia_dag->probing2();
 
-	ia_dag->iterative_revision();
+	run_stage(IA_REVISION, &search_procedure::ia_stage);
 
-	ia_dag->check_transitions_since_last_call();
+	check_convergence();
+
+	run_stage(NEWTON_STEP, &search_procedure::newton_stage);
+
+	check_uniqueness_proof();
 
 	check_convergence();
 
-	lp->reset();
+	if (!schedule->run_lp_stage(depth)) {
 
-	aa_dag->reset_vars();
+		return;
+	}
 
-	aa_dag->evaluate_all();
+	context.excellent_progress_made = false; // set by the LP pruning, see affine
 
-	lp->check_feasibility(); // FIXME Once found feasible, cannot become infeas!!!
+	run_stage(LP_STAGE, &search_procedure::lp_stage);
 
-	lp->prune(std::vector<int>()); // Cannot throw infeasible problem
+	if (context.excellent_progress_made) {
+
+		schedule->excellent_progress(depth);
+	}
 
 	check_convergence();
 
@@ -340,11 +940,89 @@ void search_procedure::contracting_step() {
 	check_convergence();
 }
 
-const double CONVERGENCE_TOL = 0.05; // FIXME Just for testing
+// Measured for the scheduler; a failed stage gained nothing
+void search_procedure::run_stage(contractor c, void (search_procedure::*stage)()) {
+
+	const interval* const box = ia_dag->get_box();
+
+	const std::vector<interval> box_before(box, box+n_vars);
+
+	schedule->start(c);
+
+	try {
+
+		(this->*stage)();
+	}
+	catch (infeasible_problem& ) {
+
+		schedule->finish(c, depth, 0.0);
+
+		throw;
+	}
+	catch (numerical_problems& ) {
+
+		schedule->finish(c, depth, 1.0);
+
+		throw;
+	}
+
+	schedule->finish(c, depth, reduction(&box_before.at(0)));
+}
+
+void search_procedure::ia_stage() {
+
+	ia_dag->iterative_revision();
+
+	ia_dag->check_transitions_since_last_call();
+}
+
+// Repeated while it makes progress: near a regular solution it converges
+// quadratically; once uniqueness is proved, the box ends in
+// check_uniqueness_proof() even if it is not narrow yet
+void search_procedure::newton_stage() {
+
+	interval* const box = &ia_dag->get_v()->at(0);
+
+	bool proved = false;
+
+	for (int i=0; i<MAX_NEWTON_STEPS; ++i) {
+
+		const std::vector<interval> box_before(box, box+n_vars);
+
+		if (newton->contract(box)) {
+
+			proved = true;
+		}
+
+		if (reduction(&box_before.at(0)) > NEWTON_REPEAT_RATIO) {
+
+			break;
+		}
+	}
+
+	unique_solution_proved = proved;
+}
+
+void search_procedure::lp_stage() {
+
+	lp->reset();
+
+	aa_dag->reset_vars();
+
+	aa_dag->evaluate_all();
+
+	lp->check_feasibility(); // FIXME Once found feasible, cannot become infeas!!!
+
+	lp->prune(std::vector<int>()); // Cannot throw infeasible problem
+}
 
 struct wide {
 
-	bool operator()(const interval& x) const { return !x.is_narrow(CONVERGENCE_TOL); }
+	explicit wide(double tol) : tol(tol) { }
+
+	bool operator()(const interval& x) const { return !x.is_narrow(tol); }
+
+	const double tol;
 };
 
 void search_procedure::check_convergence() {
@@ -352,25 +1030,65 @@ void search_procedure::check_convergence() {
 	// TODO Move convergence check to expression_graph?
 	const interval* const box = ia_dag->get_box();
 
-	const interval* const elem = std::find_if(box, box+n_vars, wide());
+	const interval* const elem = std::find_if(box, box+n_vars, wide(convergence_tol));
 
 	if (elem == box+n_vars) {
 
 		cout << "Found a solution!" << endl;
 
-		++solutions_found;
+		save_solution();
 
 		throw convergence_reached();
 	}
 }
 
+// The box contains exactly one solution, splitting it further is pointless
+void search_procedure::check_uniqueness_proof() {
+
+	if (!unique_solution_proved) {
+
+		return;
+	}
+
+	unique_solution_proved = false;
+
+	cout << "Found a solution, proved unique by interval Newton!" << endl;
+
+	++solutions_proved;
+
+	save_solution();
+
+	throw convergence_reached();
+}
+
+void search_procedure::save_solution() {
+
+	const interval* const box = ia_dag->get_box();
+
+	++solutions_found;
+
+	solution_boxes.insert(solution_boxes.end(), box, box+n_vars);
+
+	if (splits_to_first_solution < 0) {
+
+		splits_to_first_solution = splits;
+	}
+}
+
 void search_procedure::delete_box() {
 
 	cout << "Box discarded" << endl; // TODO Somewhat misplaced for true solutions
 
-	delete[] box_orig;
+	pool->release(box_orig);
 
 	box_orig = 0;
+
+	if (tree) {
+
+		tree->release(node_orig);
+
+		node_orig = 0;
+	}
 }
 
 void search_procedure::print_box() const {
@@ -380,8 +1098,7 @@ void search_procedure::print_box() const {
 
 bool search_procedure::sufficient(const double max_progress) const {
 
-	return max_progress < 0.95; // TODO Introduce options class
-	                            // FIXME See also affine::excellent_progress_made
+	return schedule->sufficient(max_progress);
 }
 
 bool search_procedure::sufficient_progress() {
@@ -405,19 +1122,23 @@ bool search_procedure::sufficient_progress() {
 
 struct diam_reduction {
 
-	double operator()(const interval& x, const interval& y) {
+	explicit diam_reduction(double tol) : tol(tol) { }
+
+	double operator()(const interval& x, const interval& y) const {
 
 		ASSERT(x.subset_of(y));
 
 		double result = 10; // TODO Magic number
 
-		if (!x.is_narrow(CONVERGENCE_TOL) && y.diameter()!=0) {
+		if (!x.is_narrow(tol) && y.diameter()!=0) {
 
 			result = x.diameter() / y.diameter();
 		}
 
 		return result;
 	}
+
+	const double tol;
 };
 
 double search_procedure::compute_max_progress() const {
@@ -426,7 +1147,7 @@ double search_procedure::compute_max_progress() const {
 
 	double reduction[n_vars];
 
-	std::transform(box_contracted, box_contracted+n_vars, box_orig, reduction, diam_reduction());
+	std::transform(box_contracted, box_contracted+n_vars, box_orig, reduction, diam_reduction(convergence_tol));
 
 	const double best_reduction = *std::min_element(reduction, reduction+n_vars);
 
@@ -438,9 +1159,24 @@ double search_procedure::compute_max_progress() const {
 	return best_reduction;
 }
 
+// Same measure as compute_max_progress(), 1 if no variable shrank
+double search_procedure::reduction(const interval* box_before) const {
+
+	const interval* const box = ia_dag->get_box();
+
+	double result = 1.0;
+
+	for (int i=0; i<n_vars; ++i) {
+
+		result = std::min(result, diam_reduction(convergence_tol)(box[i], box_before[i]));
+	}
+
+	return result;
+}
+
 void search_procedure::split() {
 
-	interval* const box_new = new interval[n_vars];
+	interval* const box_new = pool->allocate();
 
 	std::copy(box_orig, box_orig+n_vars, box_new);
 
@@ -460,15 +1196,188 @@ void search_procedure::split() {
 		mid = box_orig[index].midpoint();
 	}
 
+	// The contracted box differs from its node in a few components only
+	const split_node* const parent = tree ? tree->add(node_orig, box_orig) : 0;
+
 	box_orig[index] = interval(lb, mid);
 	box_new[index]  = interval(mid, ub);
 
-	pending_boxes.push_back(box_orig);
-	pending_boxes.push_back(box_new);
+	const split_node* const node_lo = tree ? tree->add(parent, index, box_orig[index]) : 0;
+	const split_node* const node_up = tree ? tree->add(parent, index, box_new[index])  : 0;
+
+	const box_key key_lo = key_of(box_orig, node_lo);
+	const box_key key_up = key_of(box_new, node_up);
+
+	save_warm_start(key_lo);
+	save_warm_start(key_up);
+
+	save_depth(key_lo);
+	save_depth(key_up);
+
+	save_enclosures(key_lo);
+	save_enclosures(key_up);
+
+	push_box(box_orig, node_lo);
+	push_box(box_new, node_up);
+
+	if (tree) {
+
+		tree->release(parent);
+
+		tree->release(node_orig);
+
+		node_orig = 0;
+	}
 
 	++splits;
 
 	box_orig = 0;
 }
 
+// The children start from the basis of the parent's last LP. Workers of the
+// parallel search skip this, their boxes may be stolen by other workers.
+void search_procedure::save_warm_start(box_key box) {
+
+	if (warm_start_lp && !scheduler) {
+
+		lp->save_basis(warm_starts[box]);
+	}
+}
+
+void search_procedure::load_warm_start(box_key box) {
+
+	std::map<box_key, lp_basis>::iterator itr = warm_starts.find(box);
+
+	if (itr != warm_starts.end()) {
+
+		lp->warm_start(itr->second);
+
+		warm_starts.erase(itr);
+	}
+}
+
+// The scheduler keeps its statistics per depth; the boxes of the workers
+// of the parallel search are all at depth 0 as far as it is concerned
+void search_procedure::save_depth(box_key box) {
+
+	if (!scheduler) {
+
+		depths[box] = depth + 1;
+	}
+}
+
+void search_procedure::load_depth(box_key box) {
+
+	std::map<box_key, int>::iterator itr = depths.find(box);
+
+	depth = (itr != depths.end()) ? itr->second : 0;
+
+	if (itr != depths.end()) {
+
+		depths.erase(itr);
+	}
+}
+
+// The revision of the children starts from the state of the dag at the
+// split, serial search only
+void search_procedure::save_enclosures(box_key box) {
+
+	if (inherit_enclosures && !scheduler) {
+
+		ia_dag->save_enclosures(enclosures[box]);
+	}
+}
+
+void search_procedure::load_enclosures(box_key box) {
+
+	std::map<box_key, node_enclosures<interval> >::iterator itr = enclosures.find(box);
+
+	has_inherited = (itr != enclosures.end());
+
+	if (has_inherited) {
+
+		inherited.vars.swap(itr->second.vars);
+
+		inherited.nodes.swap(itr->second.nodes);
+
+		enclosures.erase(itr);
+	}
+}
+
+// With a compact frontier, the box is replaced by its node; a box without
+// a node becomes a root of the split tree
+void search_procedure::push_box(interval* box, const split_node* node) {
+
+	if (scheduler) {
+
+		scheduler->push(worker_id, box);
+	}
+	else if (tree) {
+
+		const double p = priority(box);
+
+		pending_nodes->push(node ? node : tree->add_root(box), p);
+
+		pool->release(box);
+	}
+	else {
+
+		pending_boxes->push(box, priority(box));
+	}
+}
+
+// The hints of a spilled box are dropped, its depth is saved with it
+int search_procedure::box_spilled(const interval* box) {
+
+	warm_starts.erase(box);
+
+	enclosures.erase(box);
+
+	std::map<box_key, int>::iterator itr = depths.find(box);
+
+	const int tag = (itr != depths.end()) ? itr->second : 0;
+
+	if (itr != depths.end()) {
+
+		depths.erase(itr);
+	}
+
+	return tag;
+}
+
+void search_procedure::box_restored(const interval* box, int tag) {
+
+	depths[box] = tag;
+}
+
+struct max_diameter {
+
+	double operator()(double d, const interval& x) const { return std::max(d, x.diameter()); }
+};
+
+// Of the best-first queues; a box on which a residual is undefined goes last
+double search_procedure::priority(const interval* box) {
+
+	double result = 0.0;
+
+	if (order.order != BEST_FIRST && order.order != HYBRID) {
+
+		result = 0.0;
+	}
+	else if (order.heuristic == SMALLEST_MAX_WIDTH) {
+
+		result = std::accumulate(box, box+n_vars, 0.0, max_diameter());
+	}
+	else if (residual_ad->residuals(box, residuals)) {
+
+		result = std::accumulate(residuals.begin(), residuals.end(), 0.0, max_diameter());
+	}
+	else {
+
+		result = std::numeric_limits<double>::max();
+	}
+
+	return result;
+}
+
 }
@@ -26,16 +26,11 @@
 #include "builder.hpp"
 #include "diagnostics.hpp"
 #include "interval.hpp"
+#include "solver_context.hpp"
 #include "vector_dump.hpp"
 
 using namespace std;
 
-namespace {
-// FIXME Search algorithm should have its own sol_tracker?
-std::vector<int> found;
-
-}
-
 namespace asol {
 
 sol_tracker::sol_tracker(const problem<builder>* prob)
@@ -61,7 +56,7 @@ void sol_tracker::init() {
 
 	v = 0;
 
-	found.resize(solutions.size(), 0);
+	solver_context::current().found_solutions.resize(solutions.size(), 0);
 }
 
 sol_tracker::~sol_tracker() {
@@ -169,6 +164,8 @@ void sol_tracker::increment_found_solution_counters() {
 
 	const int n = static_cast<int> (containment.size());
 
+	std::vector<int>& found = solver_context::current().found_solutions;
+
 	for (int i=0; i<n; ++i) {
 
 		if (containment.at(i) == STRICT_CONTAINMENT) {
@@ -180,6 +177,11 @@ void sol_tracker::increment_found_solution_counters() {
 
 void sol_tracker::print_found_solutions() const {
 
+	print_counters(solver_context::current().found_solutions);
+}
+
+void sol_tracker::print_counters(const std::vector<int>& found) {
+
 	const int n = static_cast<int> (found.size());
 
 	cout << "Statistics of found solutions" << endl;
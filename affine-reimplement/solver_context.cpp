@@ -0,0 +1,83 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include "solver_context.hpp"
+#include "problem_data.hpp"
+
+namespace asol {
+
+ASOL_THREAD_LOCAL solver_context* solver_context::active(0);
+
+solver_context::solver_context() :
+
+	problem(new problem_data),
+	affine_ranges(0),
+	lp(0),
+	max_used_index(0),
+	last_variable_index(0),
+	noise_term_limit(0),
+	excellent_progress_made(false)
+{
+
+}
+
+solver_context::~solver_context() {
+
+	delete problem;
+}
+
+solver_context& solver_context::default_context() {
+
+	static solver_context context;
+
+	return context;
+}
+
+template <>
+node_state<interval>& solver_context::nodes<interval>() {
+
+	return interval_nodes;
+}
+
+template <>
+node_state<affine>& solver_context::nodes<affine>() {
+
+	return affine_nodes;
+}
+
+template <>
+node_state<builder>& solver_context::nodes<builder>() {
+
+	return builder_nodes;
+}
+
+context_scope::context_scope(solver_context& context) : previous(solver_context::active) {
+
+	solver_context::active = &context;
+}
+
+context_scope::~context_scope() {
+
+	solver_context::active = previous;
+}
+
+}
@@ -0,0 +1,214 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include "split_tree.hpp"
+#include "diagnostics.hpp"
+#include "interval.hpp"
+
+namespace asol {
+
+struct change {
+
+	change(int i, const interval& x) : index(i), bounds(x) { }
+
+	int index;
+
+	interval bounds;
+};
+
+// The changes follow the node in the same allocation; a node without
+// parent holds the full box instead
+struct split_node {
+
+	const split_node* parent;
+
+	int refs;
+
+	int n_changes;
+
+	change* changes() { return reinterpret_cast<change*>(this+1); }
+
+	const change* changes() const { return reinterpret_cast<const change*>(this+1); }
+
+	interval* box() { return reinterpret_cast<interval*>(this+1); }
+
+	const interval* box() const { return reinterpret_cast<const interval*>(this+1); }
+};
+
+namespace {
+
+bool same(const interval& x, const interval& y) {
+
+	return x.inf() == y.inf() && x.sup() == y.sup();
+}
+
+}
+
+split_tree::split_tree(int number_of_variables)
+: n_vars(number_of_variables),
+  scratch(n_vars),
+  n_nodes(0),
+  bytes(0),
+  peak_bytes(0)
+{
+
+}
+
+std::size_t split_tree::size(const split_node* parent, int n_changes) const {
+
+	const std::size_t payload = parent ? n_changes*sizeof(change) : n_vars*sizeof(interval);
+
+	return sizeof(split_node) + payload;
+}
+
+split_node* split_tree::new_node(const split_node* parent, int n_changes) {
+
+	split_node* node = static_cast<split_node*>(::operator new(size(parent, n_changes)));
+
+	node->parent = parent;
+
+	node->refs = 1;
+
+	node->n_changes = n_changes;
+
+	if (parent) {
+
+		++const_cast<split_node*>(parent)->refs;
+	}
+
+	++n_nodes;
+
+	count(size(parent, n_changes));
+
+	return node;
+}
+
+void split_tree::count(std::ptrdiff_t delta) {
+
+	bytes += delta;
+
+	if (bytes > peak_bytes) {
+
+		peak_bytes = bytes;
+	}
+}
+
+const split_node* split_tree::add_root(const interval* box) {
+
+	split_node* node = new_node(0, n_vars);
+
+	std::uninitialized_copy(box, box+n_vars, node->box());
+
+	return node;
+}
+
+const split_node* split_tree::add(const split_node* parent, const interval* box) {
+
+	materialize(parent, &scratch.at(0));
+
+	int n_changes = 0;
+
+	for (int i=0; i<n_vars; ++i) {
+
+		if (!same(box[i], scratch[i])) {
+
+			++n_changes;
+		}
+	}
+
+	// A long diff would cost more than the full box, and would keep the
+	// ancestors alive for nothing
+	if (size(parent, n_changes) >= size(0, n_vars)) {
+
+		return add_root(box);
+	}
+
+	split_node* node = new_node(parent, n_changes);
+
+	change* c = node->changes();
+
+	for (int i=0; i<n_vars; ++i) {
+
+		if (!same(box[i], scratch[i])) {
+
+			new (c++) change(i, box[i]);
+		}
+	}
+
+	return node;
+}
+
+const split_node* split_tree::add(const split_node* parent, int index, const interval& bounds) {
+
+	ASSERT2(0<=index && index<n_vars, "index: "<<index);
+
+	split_node* node = new_node(parent, 1);
+
+	new (node->changes()) change(index, bounds);
+
+	return node;
+}
+
+void split_tree::materialize(const split_node* node, interval* box) {
+
+	path.clear();
+
+	for ( ; node; node = node->parent) {
+
+		path.push_back(node);
+	}
+
+	ASSERT(!path.empty());
+
+	std::copy(path.back()->box(), path.back()->box()+n_vars, box);
+
+	for (int k=static_cast<int>(path.size())-2; k>=0; --k) {
+
+		const change* c = path[k]->changes();
+
+		for (int i=0; i<path[k]->n_changes; ++i) {
+
+			box[c[i].index] = c[i].bounds;
+		}
+	}
+}
+
+void split_tree::release(const split_node* node) {
+
+	while (node && --const_cast<split_node*>(node)->refs == 0) {
+
+		const split_node* parent = node->parent;
+
+		count(-static_cast<std::ptrdiff_t>(size(parent, node->n_changes)));
+
+		--n_nodes;
+
+		::operator delete(const_cast<split_node*>(node));
+
+		node = parent;
+	}
+}
+
+}
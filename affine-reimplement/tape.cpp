@@ -0,0 +1,151 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include "tape.hpp"
+#include "diagnostics.hpp"
+#include "evaluate.hpp"
+#include "gap_info.hpp"
+
+namespace asol {
+
+template <typename T>
+inline void save_gap(std::vector<gap_info<T> >* gaps, int index, const T& gap) {
+
+	if (gaps) {
+
+		gaps->push_back(gap_info<T>(index, gap));
+	}
+}
+
+template <typename T>
+void tape_interpreter<T>::evaluate(T* v, int first, int last) const {
+
+	ASSERT2(0<=first && last<size(), "first, last, size: "<<first<<", "<<last<<", "<<size());
+
+	const tape_record* const t = &tape[0];
+
+	for (int i=first; i<=last; ++i) {
+
+		const tape_record* const r = t + i;
+
+		switch (r->op) {
+
+		case OP_ADD: add(v[r->z], v[r->x], v[r->y]); break;
+
+		case OP_SUB: sub(v[r->z], v[r->x], v[r->y]); break;
+
+		case OP_MUL: mul(v[r->z], v[r->x], v[r->y]); break;
+
+		// Arg2 cannot contain zero, extended division is not applicable
+		case OP_DIV: div(v[r->z], v[r->x], v[r->y]); break;
+
+		case OP_SQR: sqr(v[r->z], v[r->x]); break;
+
+		case OP_EXP: exp(v[r->z], v[r->x]); break;
+
+		case OP_LOG: log(v[r->z], v[r->x]); break;
+
+		case OP_EQUALITY: v[r->z].equals(r->rhs); break;
+
+		case OP_CSE: break; // TODO Not clear what to do
+
+		case OP_LESS_EQ: v[r->z].less_than_or_equal_to(v[r->x]); break;
+
+		default: ASSERT2(false, "unknown opcode: "<<r->op);
+		}
+	}
+}
+
+template <typename T>
+void tape_interpreter<T>::revise(T* v, int first, int last, std::vector<gap_info<T> >* gaps) const {
+
+	ASSERT2(0<=first && last<size(), "first, last, size: "<<first<<", "<<last<<", "<<size());
+
+	const tape_record* const t = &tape[0];
+
+	T gap;
+
+	for (int i=last; i>=first; --i) {
+
+		const tape_record* const r = t + i;
+
+		switch (r->op) {
+
+		case OP_ADD: addition_inverse(v[r->z], v[r->x], v[r->y]); break;
+
+		case OP_SUB: substraction_inverse(v[r->z], v[r->x], v[r->y]); break;
+
+		case OP_MUL:
+			// y = z/x
+			if (extended_division(v[r->z], v[r->x], v[r->y], gap)) {
+
+				save_gap(gaps, r->y, gap);
+			}
+			// x = z/y
+			if (extended_division(v[r->z], v[r->y], v[r->x], gap)) {
+
+				save_gap(gaps, r->x, gap);
+			}
+
+			mul(v[r->z], v[r->x], v[r->y]);
+			break;
+
+		case OP_DIV:
+			// Only y = x/z can generate gap
+			if (division_inverse(v[r->z], v[r->x], v[r->y], gap)) {
+
+				save_gap(gaps, r->y, gap);
+			}
+			break;
+
+		case OP_SQR:
+
+			if (sqr_inverse(v[r->z], v[r->x], gap)) {
+
+				save_gap(gaps, r->x, gap);
+			}
+			break;
+
+		case OP_EXP: exp_inverse(v[r->z], v[r->x]); break;
+
+		case OP_LOG: log_inverse(v[r->z], v[r->x]); break;
+
+		case OP_EQUALITY: equality_constraint_inverse(v[r->z], r->rhs); break;
+
+		case OP_CSE: break; // TODO Not clear what to do
+
+		// TODO Is this the best we can do?
+		case OP_LESS_EQ: v[r->z].less_than_or_equal_to(v[r->x]); break;
+
+		default: ASSERT2(false, "unknown opcode: "<<r->op);
+		}
+	}
+}
+
+template class tape_interpreter<interval>;
+
+// Same as with the primitives: revise() is not applicable to affine
+template<> void tape_interpreter<affine>::revise(affine* , int , int , std::vector<gap_info<affine> >* ) const { }
+
+template class tape_interpreter<affine>;
+
+}
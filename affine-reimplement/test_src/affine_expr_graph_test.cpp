@@ -20,13 +20,19 @@
 //
 //==============================================================================
 
+#include <algorithm>
+#include <iostream>
+#include <vector>
 #include "affine.hpp"
 #include "builder.hpp"
 #include "diagnostics.hpp"
 #include "expression_graph.hpp"
+#include "index_recorder.hpp"
 #include "interval.hpp"
+#include "lp_solver.hpp"
 #include "problem.hpp"
 #include "problem_data.hpp"
+#include "solver_context.hpp"
 
 namespace asol {
 
@@ -73,4 +79,112 @@ void affine_expr_graph_test(const problem<builder>* prob) {
 	builder::reset();
 }
 
+namespace {
+
+// The ranges of the affine dag on the initial box, evaluated in a context
+// of its own with the given noise term limit; the equality constraints go
+// to an LP as in the LP stage of search_procedure
+const std::vector<interval> affine_ranges(const problem_data* representation, int limit,
+                                          std::vector<interval>& merged, int& max_terms)
+{
+	solver_context context;
+
+	const context_scope scope(context);
+
+	affine::set_noise_term_limit(limit);
+
+	const int n_vars = representation->number_of_variables();
+
+	expression_graph<interval> ia_dag(representation, DoubleArray2D());
+
+	ia_dag.evaluate_all();
+
+	affine::set_vector(ia_dag.get_v());
+
+	expression_graph<affine> aa_dag(representation, IntArray2D());
+
+	lp_solver lp(LP_DUAL_SIMPLEX);
+
+	lp.set_pruning_indices(index_recorder(representation).lp_pruning_index_sets());
+
+	lp.set_number_of_vars(n_vars);
+
+	lp.set_affine_vars(aa_dag.get_v());
+
+	affine::set_lp_solver(&lp);
+
+	lp.reset();
+
+	aa_dag.reset_vars();
+
+	aa_dag.evaluate_all();
+
+	const std::vector<affine>& v = *aa_dag.get_v();
+
+	std::vector<interval> ranges;
+
+	merged.clear();
+
+	max_terms = 0;
+
+	for (size_t i=0; i<v.size(); ++i) {
+
+		const int terms = v[i].number_of_noise_terms();
+
+		ASSERT2(limit==0 || terms <= n_vars+limit, "node: "<<i<<", terms: "<<terms<<", limit: "<<limit);
+
+		max_terms = std::max(max_terms, terms);
+
+		ranges.push_back(v[i].range());
+
+		merged.push_back(v[i].merge());
+	}
+
+	return ranges;
+}
+
+bool encloses(const interval& x, const interval& y, double tol) {
+
+	return x.inf() <= y.inf() + tol && y.sup() <= x.sup() + tol;
+}
+
+}
+
+void noise_term_limit_test(const problem<builder>* prob, int k) {
+
+	ASSERT2(k > 0, "k: "<<k);
+
+	const problem_data* representation = build_repr(prob);
+
+	std::vector<interval> merged_unlimited, merged_limited;
+
+	int max_unlimited = 0, max_limited = 0;
+
+	const std::vector<interval> unlimited = affine_ranges(representation, 0, merged_unlimited, max_unlimited);
+
+	const std::vector<interval> limited = affine_ranges(representation, k, merged_limited, max_limited);
+
+	// Otherwise nothing was folded
+	ASSERT2(max_limited < max_unlimited, "terms: "<<max_limited<<", without limit: "<<max_unlimited);
+
+	ASSERT(limited.size() == unlimited.size());
+
+	for (size_t i=0; i<limited.size(); ++i) {
+
+		ASSERT2(encloses(limited[i], unlimited[i], 0.0), "node: "<<i<<", "<<limited[i]<<" misses "<<unlimited[i]);
+
+		const double tol = 1.0e-12*(1.0 + merged_unlimited[i].diameter());
+
+		ASSERT2(encloses(merged_limited[i], merged_unlimited[i], tol),
+				"node: "<<i<<", "<<merged_limited[i]<<" misses "<<merged_unlimited[i]);
+	}
+
+	std::cout << "Noise term limit " << k << ": " << limited.size() << " forms of at most " << max_limited;
+	std::cout << " terms enclose the unlimited ones of at most " << max_unlimited << std::endl;
+
+	delete prob;
+
+	builder::reset();
+}
+
 }
@@ -30,6 +30,10 @@ namespace asol {
 
 void affine_expr_graph_test(const problem<builder>* prob);
 
+// Evaluates the affine dag with at most k noise terms of the non-variables
+// per form and compares it to the evaluation without a limit
+void noise_term_limit_test(const problem<builder>* prob, int k);
+
 }
 
 #endif // AFFINE_EXPR_GRAPH_TEST_HPP_
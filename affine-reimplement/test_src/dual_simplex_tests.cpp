@@ -0,0 +1,520 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "dual_simplex_tests.hpp"
+#include "dual_simplex_impl.hpp"
+#include "farkas_cache.hpp"
+#include "lp_pruning.hpp"
+#include "rigorous_lp_impl.hpp"
+#include "sparse_rows.hpp"
+#include "diagnostics.hpp"
+#include "exceptions.hpp"
+
+using namespace std;
+
+namespace asol {
+
+namespace {
+
+const double TOL = 1.0e-12;
+
+void add_row(lp_impl* lp, double a1, double a2, double lb, double ub) {
+
+	const int index[] = { 0, 1, 2 };
+
+	const double value[] = { 0.0, a1, a2 };
+
+	lp->set_col_bounds(1, -1, 1);
+
+	lp->set_col_bounds(2, -1, 1);
+
+	lp->add_eq_row(index, value, 2, lb, ub);
+}
+
+void check_bounds(lp_impl* lp, int i, double lb, double ub) {
+
+	const double l = lp->tighten_col_lb(i, -1);
+
+	const double u = lp->tighten_col_ub(i,  1);
+
+	ASSERT2(fabs(l-lb)<TOL && fabs(u-ub)<TOL, "i: "<<i<<", ["<<l<<", "<<u<<"]");
+}
+
+void redundant_row(lp_impl* lp) {
+
+	lp->reset();
+
+	add_row(lp, 1, 1, -3, 3);
+
+	lp->run_simplex();
+
+	check_bounds(lp, 1, -1, 1);
+
+	check_bounds(lp, 2, -1, 1);
+}
+
+void equal_columns(lp_impl* lp) {
+
+	lp->reset();
+
+	add_row(lp, 1, -1, 0, 0);
+
+	lp->set_col_bounds(1, -1, 0.5);
+
+	lp->run_simplex();
+
+	check_bounds(lp, 2, -1, 0.5);
+}
+
+void range_row(lp_impl* lp) {
+
+	lp->reset();
+
+	add_row(lp, 1,  1, 1.5, 2);
+
+	add_row(lp, 1, -1, 0, 0.25);
+
+	lp->run_simplex();
+
+	check_bounds(lp, 1, 0.75, 1);
+
+	check_bounds(lp, 2, 0.625, 1);
+}
+
+void infeasible_row(lp_impl* lp) {
+
+	lp->reset();
+
+	add_row(lp, 1, 1, 2.5, 3);
+
+	bool thrown = false;
+
+	try {
+
+		lp->run_simplex();
+	}
+	catch (infeasible_problem& ) {
+
+		thrown = true;
+	}
+
+	ASSERT(thrown);
+}
+
+double uniform(double lo, double hi) {
+
+	return lo + (hi-lo)*(std::rand()/static_cast<double>(RAND_MAX));
+}
+
+// A row  a1*x1 + a2*x2  with its bounds
+struct random_row {
+	double a1;
+	double a2;
+	double lb;
+	double ub;
+};
+
+bool satisfies(const vector<random_row>& rows, double x1, double x2) {
+
+	const double tol = 1.0e-9;
+
+	if (fabs(x1) > 1+tol || fabs(x2) > 1+tol) {
+
+		return false;
+	}
+
+	for (size_t k=0; k<rows.size(); ++k) {
+
+		const double r = rows[k].a1*x1 + rows[k].a2*x2;
+
+		if (r < rows[k].lb-tol || r > rows[k].ub+tol) {
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// The bounds of x1 and x2 over the vertices: intersections of two of the
+// lines of the column and row bounds; false if there is no feasible vertex
+bool vertex_enumeration(const vector<random_row>& rows, double lo[2], double up[2]) {
+
+	vector<double> a, b, c; // a*x1 + b*x2 = c
+
+	for (int bound=-1; bound<=1; bound+=2) {
+
+		a.push_back(1.0); b.push_back(0.0); c.push_back(bound);
+
+		a.push_back(0.0); b.push_back(1.0); c.push_back(bound);
+	}
+
+	for (size_t k=0; k<rows.size(); ++k) {
+
+		a.push_back(rows[k].a1); b.push_back(rows[k].a2); c.push_back(rows[k].lb);
+
+		a.push_back(rows[k].a1); b.push_back(rows[k].a2); c.push_back(rows[k].ub);
+	}
+
+	bool feasible = false;
+
+	for (size_t i=0; i<a.size(); ++i) {
+
+		for (size_t j=i+1; j<a.size(); ++j) {
+
+			const double det = a[i]*b[j] - b[i]*a[j];
+
+			if (fabs(det) < 1.0e-9) {
+
+				continue;
+			}
+
+			const double x[] = { (c[i]*b[j] - b[i]*c[j])/det, (a[i]*c[j] - c[i]*a[j])/det };
+
+			if (!satisfies(rows, x[0], x[1])) {
+
+				continue;
+			}
+
+			for (int k=0; k<2; ++k) {
+
+				lo[k] = feasible ? std::min(lo[k], x[k]) : x[k];
+
+				up[k] = feasible ? std::max(up[k], x[k]) : x[k];
+			}
+
+			feasible = true;
+		}
+	}
+
+	return feasible;
+}
+
+// Random LPs of 1 to 4 rows over 2 columns, compared to vertex enumeration.
+// Most rows are satisfied by a random point, the rest are random and make
+// some of the LPs infeasible. The rigorous bounds must enclose the exact ones.
+void random_lps(lp_impl* lp, bool rigorous) {
+
+	const double tol = 1.0e-7;
+
+	lp->add_cols(2);
+
+	std::srand(42);
+
+	int infeasible = 0;
+
+	for (int t=0; t<2000; ++t) {
+
+		lp->reset();
+
+		vector<random_row> rows(1 + std::rand()%4);
+
+		const double x1 = uniform(-1, 1), x2 = uniform(-1, 1);
+
+		for (size_t k=0; k<rows.size(); ++k) {
+
+			random_row& row = rows[k];
+
+			row.a1 = uniform(-1, 1);
+
+			row.a2 = uniform(-1, 1);
+
+			const double r = (std::rand()%4 == 0) ? uniform(-2, 2) : row.a1*x1 + row.a2*x2;
+
+			const bool equality = (std::rand()%5 == 0);
+
+			row.lb = equality ? r : r - uniform(0, 0.5);
+
+			row.ub = equality ? r : r + uniform(0, 0.5);
+
+			add_row(lp, row.a1, row.a2, row.lb, row.ub);
+		}
+
+		double lo[2], up[2];
+
+		const bool feasible = vertex_enumeration(rows, lo, up);
+
+		try {
+
+			lp->run_simplex();
+		}
+		catch (infeasible_problem& ) {
+
+			ASSERT2(!feasible, "LP "<<t<<" found infeasible");
+
+			++infeasible;
+
+			continue;
+		}
+
+		ASSERT2(feasible, "LP "<<t<<" found feasible");
+
+		for (int i=1; i<=2; ++i) {
+
+			const double l = lp->tighten_col_lb(i, -1);
+
+			const double u = lp->tighten_col_ub(i,  1);
+
+			const double exact_lo = lo[i-1], exact_up = up[i-1];
+
+			ASSERT2(fabs(l-exact_lo)<tol && fabs(u-exact_up)<tol,
+					"LP "<<t<<", i: "<<i<<", ["<<l<<", "<<u<<"], exact: ["<<exact_lo<<", "<<exact_up<<"]");
+
+			ASSERT2(!rigorous || (l <= exact_lo+1.0e-9 && exact_up-1.0e-9 <= u),
+					"LP "<<t<<", i: "<<i<<", ["<<l<<", "<<u<<"] misses ["<<exact_lo<<", "<<exact_up<<"]");
+		}
+	}
+
+	ASSERT2(infeasible > 100 && infeasible < 1900, "infeasible: "<<infeasible);
+
+	delete lp;
+}
+
+void cloned_basis(lp_impl* lp) {
+
+	lp->reset();
+
+	add_row(lp, 1,  1, 1.5, 2);
+
+	lp->run_simplex();
+
+	lp_basis basis;
+
+	lp->save_basis(basis);
+
+	lp_impl* copy = lp->clone();
+
+	copy->load_basis(basis);
+
+	check_bounds(copy, 1, 0.5, 1);
+
+	delete copy;
+}
+
+// The certificate of an infeasible LP must also prove a similar one
+void cached_certificate(lp_impl* lp) {
+
+	const int index[] = { 0, 1, 2 };
+
+	const double value[] = { 0.0, 1.0, 1.0 };
+
+	sparse_rows rows;
+
+	rows.add(index, value, 2, 2.5, 3);
+
+	infeasible_row(lp);
+
+	vector<double> y;
+
+	ASSERT(lp->infeasibility_certificate(y));
+
+	farkas_cache cache(1);
+
+	cache.add(y, rows, 2);
+
+	sparse_rows sibling;
+
+	sibling.add(index, value, 2, 2.1, 2.2);
+
+	ASSERT(cache.proves_infeasible(sibling, 2));
+
+	sparse_rows feasible;
+
+	feasible.add(index, value, 2, 1.9, 2.2);
+
+	ASSERT(!cache.proves_infeasible(feasible, 2));
+}
+
+// The verified bounds may only be looser than the optimum, and not by much
+void rigorous_bounds() {
+
+	lp_impl* lp = new rigorous_lp_impl(new dual_simplex_impl);
+
+	lp->add_cols(2);
+
+	lp->reset();
+
+	add_row(lp, 1,  1, 1.5, 2);
+
+	add_row(lp, 1, -1, 0, 0.1);
+
+	lp->run_simplex();
+
+	const double lb = lp->tighten_col_lb(2, -1);
+
+	const double ub = lp->tighten_col_ub(1,  1);
+
+	ASSERT2(lb <= 0.7 && 0.7-lb < 1.0e-12, "lb: "<<lb);
+
+	ASSERT2(ub >= 1.0 && ub-1.0 < 1.0e-12, "ub: "<<ub);
+
+	delete lp;
+}
+
+// Minimizing x1 leaves x2 and x3 at their upper bounds, their reduced costs
+// give their lower bounds before they are solved for. None of the bounds
+// may cut off the feasible set: each variable is in [-0.5, 1].
+void reduced_cost_pruning(lp_impl* lp) {
+
+	const int index[] = { 0, 1, 2, 3 };
+
+	const double value[] = { 0.0, 1.0, 1.0, 1.0 };
+
+	lp->add_cols(3);
+
+	lp->reset();
+
+	for (int j=1; j<=3; ++j) {
+
+		lp->set_col_bounds(j, -1, 1);
+	}
+
+	lp->add_eq_row(index, value, 3, 1.5, 3);
+
+	lp->run_simplex();
+
+	vector<int> index_set(index+1, index+4);
+
+	const lp_pruning pruning(lp, index_set);
+
+	const vector<double>& lo = pruning.new_lb_for_epsilon();
+
+	const vector<double>& up = pruning.new_ub_for_epsilon();
+
+	for (int i=0; i<3; ++i) {
+
+		ASSERT2(lo.at(i) <= -0.5 && -0.5-lo.at(i) < 1.0e-9, "i: "<<i<<", lb: "<<lo.at(i));
+
+		ASSERT2(up.at(i) >= 1.0 && up.at(i)-1.0 < 1.0e-9, "i: "<<i<<", ub: "<<up.at(i));
+	}
+
+	ASSERT(pruning.tightened_by_reduced_costs() > 0);
+
+	delete lp;
+}
+
+// x1+x2+x3 in [1.5, 3], x3-x4 in [0, 0.5] and x4+x5+x6 in [-3, -1.5]
+lp_impl* chained_rows() {
+
+	lp_impl* lp = new rigorous_lp_impl(new dual_simplex_impl);
+
+	lp->add_cols(6);
+
+	lp->reset();
+
+	for (int j=1; j<=6; ++j) {
+
+		lp->set_col_bounds(j, -1, 1);
+	}
+
+	const int first[] = { 0, 1, 2, 3 }, second[] = { 0, 3, 4 }, third[] = { 0, 4, 5, 6 };
+
+	const double ones[] = { 0.0, 1.0, 1.0, 1.0 }, diff[] = { 0.0, 1.0, -1.0 };
+
+	lp->add_eq_row(first, ones, 3, 1.5, 3);
+
+	lp->add_eq_row(second, diff, 2, 0, 0.5);
+
+	lp->add_eq_row(third, ones, 3, -3, -1.5);
+
+	lp->run_simplex();
+
+	return lp;
+}
+
+// The workers solve the subproblems in a different order on their own
+// clones, the bounds must be the same as with a single thread
+void parallel_pruning() {
+
+	const int index[] = { 1, 2, 3, 4, 5, 6 };
+
+	const vector<int> index_set(index, index+6);
+
+	lp_impl* serial_lp = chained_rows();
+
+	lp_impl* parallel_lp = chained_rows();
+
+	const lp_pruning serial(serial_lp, index_set);
+
+	const lp_pruning parallel(parallel_lp, index_set, 3);
+
+	for (int i=0; i<6; ++i) {
+
+		const double lo = serial.new_lb_for_epsilon().at(i), up = serial.new_ub_for_epsilon().at(i);
+
+		const double par_lo = parallel.new_lb_for_epsilon().at(i), par_up = parallel.new_ub_for_epsilon().at(i);
+
+		ASSERT2(fabs(lo-par_lo) < 1.0e-9 && fabs(up-par_up) < 1.0e-9,
+				"i: "<<i<<", serial: ["<<lo<<", "<<up<<"], parallel: ["<<par_lo<<", "<<par_up<<"]");
+	}
+
+	delete serial_lp;
+
+	delete parallel_lp;
+}
+
+}
+
+// Also exercises the rows kept across reset(): each LP has fewer or more
+// rows than the previous one
+void run_dual_simplex_test() {
+
+	lp_impl* lp = new dual_simplex_impl;
+
+	lp->add_cols(2);
+
+	range_row(lp);
+
+	redundant_row(lp);
+
+	equal_columns(lp);
+
+	infeasible_row(lp);
+
+	range_row(lp);
+
+	cloned_basis(lp);
+
+	cached_certificate(lp);
+
+	delete lp;
+
+	rigorous_bounds();
+
+	reduced_cost_pruning(new dual_simplex_impl);
+
+	reduced_cost_pruning(new rigorous_lp_impl(new dual_simplex_impl));
+
+	parallel_pruning();
+
+	random_lps(new dual_simplex_impl, false);
+
+	random_lps(new rigorous_lp_impl(new dual_simplex_impl), true);
+
+	cout << "Dual simplex tests passed" << endl;
+}
+
+}
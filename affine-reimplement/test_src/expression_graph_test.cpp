@@ -21,17 +21,22 @@
 //==============================================================================
 
 #include <algorithm>
+#include <ctime>
 #include <functional>
 #include <iostream>
 #include <iomanip>
 #include "expression_graph_test.hpp"
 #include "builder.hpp"
+#include "code_generator.hpp"
 #include "diagnostics.hpp"
+#include "exceptions.hpp"
 #include "expression_graph.hpp"
 #include "floating_point_tol.hpp"
 #include "gap_probing.hpp"
 #include "index_recorder.hpp"
 #include "interval.hpp"
+#include "interval_batch.hpp"
+#include "interval_newton.hpp"
 #include "problem.hpp"
 #include "problem_data.hpp"
 
@@ -45,6 +50,8 @@ vector<ivector> sol_boxes;
 
 const double AMOUNT(0.01);
 
+const double REQUEUE_THRESHOLD(0.01);
+
 }
 
 namespace asol {
@@ -227,6 +234,74 @@ void test_solutions_iterative_revise(const problem<builder>* prob) {
 	test_solutions(dag, &expression_graph<interval>::iterative_revision_save_gaps);
 }
 
+const ivector revise_with_strategy(expression_graph<interval>& dag,
+                                   const ivector& box,
+                                   const vector<double>& sol,
+                                   revision_strategy strategy)
+{
+	dag.set_box(&(box.at(0)), box.size());
+
+	dag.set_revision_strategy(strategy);
+
+	const int revisions_before = dag.constraint_revisions();
+
+	dag.iterative_revision();
+
+	const int revisions = dag.constraint_revisions() - revisions_before;
+
+	cout << (strategy==PREFIX_SWEEP ? "Prefix sweep" : "Worklist") << ", ";
+
+	cout << "constraint revisions: " << revisions << endl;
+
+	dag.show_variables(cout);
+
+	const interval* const x = dag.get_box();
+
+	const int n = static_cast<int> (box.size());
+
+	for (int j=0; j<n; ++j) {
+
+		ASSERT2(x[j].contains(sol.at(j)),"x["<<j<<"]: "<<x[j]<<", sol: "<<sol.at(j));
+	}
+
+	return ivector(x, x+n);
+}
+
+void compare_revision_strategies(const problem<builder>* prob) {
+
+	DoubleArray2D solutions(prob->solutions());
+
+	expression_graph<interval> dag(build(prob), solutions);
+
+	builder::reset();
+
+	dag.set_requeue_threshold(REQUEUE_THRESHOLD);
+
+	const int n_sol = static_cast<int> (sol_boxes.size());
+
+	for (int i=0; i<n_sol; ++i) {
+
+		cout << endl << "Comparing strategies on solution " << (i+1) << " of " << n_sol << endl;
+
+		const ivector& box = sol_boxes.at(i);
+
+		const vector<double>& sol = solutions.at(i);
+
+		const ivector sweep = revise_with_strategy(dag, box, sol, PREFIX_SWEEP);
+
+		const ivector worklist = revise_with_strategy(dag, box, sol, CONSTRAINT_WORKLIST);
+
+		// The worklist stops requeueing below the threshold, the sweep does not
+		for (size_t j=0; j<box.size(); ++j) {
+
+			const double slack = REQUEUE_THRESHOLD*box.at(j).diameter();
+
+			ASSERT2(worklist.at(j).diameter() <= sweep.at(j).diameter() + slack,
+					"j: "<<j<<", worklist: "<<worklist.at(j)<<", sweep: "<<sweep.at(j));
+		}
+	}
+}
+
 // FIXME Duplication and buggy index set; replace with the index set given by AMPL?
 void test_solutions_probing(const problem<builder>* prob) {
 
@@ -344,5 +419,260 @@ void index_recorder_test(const problem<builder>* prob) {
 	dag.show_variables(cout);
 }
 
+// The solution boxes and their copies shifted off the solution in the first variable
+const vector<ivector> batch_test_boxes() {
+
+	vector<ivector> boxes(sol_boxes);
+
+	for (size_t i=0; i<sol_boxes.size(); ++i) {
+
+		ivector box(sol_boxes.at(i));
+
+		const interval& x = box.at(0);
+
+		box.at(0) = interval(x.sup()+AMOUNT, x.sup()+2*AMOUNT);
+
+		boxes.push_back(box);
+	}
+
+	return boxes;
+}
+
+// One forward and backward sweep must give identical results lane by lane
+void compare_batch_with_scalar(const problem<builder>* prob) {
+
+	DoubleArray2D solutions(prob->solutions());
+
+	const problem_data* const p = build(prob);
+
+	expression_graph<interval> dag(p, solutions);
+
+	const vector<ivector> boxes = batch_test_boxes();
+
+	const int n_boxes = static_cast<int> (boxes.size());
+
+	interval_batch batch(p, n_boxes);
+
+	builder::reset();
+
+	for (int i=0; i<n_boxes; ++i) {
+
+		batch.set_box(i, &boxes.at(i).at(0));
+	}
+
+	batch.evaluate_all();
+
+	batch.revise_all();
+
+	const int n_vars = static_cast<int> (boxes.at(0).size());
+
+	ivector box(n_vars);
+
+	int infeasible = 0;
+
+	for (int i=0; i<n_boxes; ++i) {
+
+		bool feasible = true;
+
+		try {
+
+			dag.set_box(&boxes.at(i).at(0), n_vars);
+
+			dag.evaluate_all();
+
+			dag.revise_all();
+		}
+		catch (infeasible_problem& ) {
+
+			feasible = false;
+
+			++infeasible;
+		}
+
+		ASSERT2(feasible==batch.feasible(i), "lane "<<i);
+
+		if (!feasible) {
+			continue;
+		}
+
+		batch.get_box(i, &box.at(0));
+
+		const interval* const expected = dag.get_box();
+
+		for (int j=0; j<n_vars; ++j) {
+
+			const bool same = box.at(j).inf()==expected[j].inf() && box.at(j).sup()==expected[j].sup();
+
+			ASSERT2(same, "lane "<<i<<", variable "<<j<<": "<<box.at(j)<<", "<<expected[j]);
+		}
+	}
+
+	cout << "Boxes: " << n_boxes << ", infeasible: " << infeasible << ", batch and scalar agree" << endl;
+}
+
+// Both modes must give the same sparsity pattern and overlapping entries
+void compare_jacobians(interval_ad& ad, const ivector& box) {
+
+	interval_jacobian forward, reverse;
+
+	ASSERT(ad.jacobian_forward(&box.at(0), forward));
+
+	ASSERT(ad.jacobian_reverse(&box.at(0), reverse));
+
+	ASSERT(forward.start==reverse.start && forward.col==reverse.col);
+
+	for (size_t k=0; k<forward.val.size(); ++k) {
+
+		const interval& x = forward.val.at(k);
+
+		const interval& y = reverse.val.at(k);
+
+		ASSERT2(!disjoint(x, y), "forward: "<<x<<", reverse: "<<y);
+	}
+}
+
+void newton_on_box(const problem_data* p, newton_method method, const ivector& box_orig, const double* sol) {
+
+	interval_newton newton(p, method);
+
+	ivector box(box_orig);
+
+	bool unique = false;
+
+	for (int i=0; i<8 && !unique; ++i) {
+
+		unique = newton.contract(&box.at(0));
+	}
+
+	double width_before = 0, width_after = 0;
+
+	for (size_t i=0; i<box.size(); ++i) {
+
+		ASSERT2(box.at(i).contains(sol[i]), "solution lost, variable "<<i<<", "<<box.at(i));
+
+		width_before += box_orig.at(i).diameter();
+
+		width_after  += box.at(i).diameter();
+	}
+
+	cout << (method==NEWTON_GAUSS_SEIDEL ? "Gauss-Seidel" : "Krawczyk") << ", unique: ";
+
+	cout << (unique ? "yes" : "no") << ", sum of widths: " << width_before << " -> " << width_after << endl;
+}
+
+// The Newton step must keep the solution in the narrowed solution boxes
+void test_interval_newton(const problem<builder>* prob) {
+
+	DoubleArray2D solutions(prob->solutions());
+
+	const problem_data* const p = build(prob);
+
+	interval_ad ad(p);
+
+	ASSERT(ad.square_system());
+
+	const int n_sol = static_cast<int> (sol_boxes.size());
+
+	for (int i=0; i<n_sol; ++i) {
+
+		cout << "Solution " << (i+1) << " of " << n_sol << endl;
+
+		ivector box(sol_boxes.at(i));
+
+		compare_jacobians(ad, box);
+
+		for (size_t j=0; j<box.size(); ++j) {
+
+			box.at(j).intersect(interval(sub_tol(solutions[i][j], 1.0e-6), add_tol(solutions[i][j], 1.0e-6)));
+		}
+
+		newton_on_box(p, NEWTON_GAUSS_SEIDEL, box, &solutions[i][0]);
+
+		newton_on_box(p, NEWTON_KRAWCZYK, box, &solutions[i][0]);
+	}
+
+	builder::reset();
+}
+
+void generate_kernel(const problem<builder>* prob, const char* name, const char* directory) {
+
+	const code_generator generator(build(prob), name);
+
+	builder::reset();
+
+	generator.write_files(directory);
+
+	cout << "Kernel " << name << " written to " << directory << endl;
+}
+
+double milliseconds(const clock_t ticks) {
+
+	return (1000.0*ticks)/CLOCKS_PER_SEC;
 }
 
+// Forward and backward sweep on each solution box, generic vs. generated
+void kernel_benchmark(const problem<builder>* prob, const generated_kernel& kernel, int repeat) {
+
+	DoubleArray2D solutions(prob->solutions());
+
+	expression_graph<interval> dag(build(prob), solutions);
+
+	builder::reset();
+
+	const vector<interval>& v = *dag.get_v();
+
+	ASSERT2(static_cast<int>(v.size())==kernel.number_of_nodes,"kernel is out of date, nodes: "<<v.size());
+
+	vector<interval> w(v.size());
+
+	clock_t generic = 0, generated = 0;
+
+	const int n_sol = static_cast<int> (sol_boxes.size());
+
+	for (int i=0; i<n_sol; ++i) {
+
+		const interval* const box = &sol_boxes.at(i).at(0);
+
+		const int n_vars = static_cast<int> (sol_boxes.at(i).size());
+
+		clock_t start = clock();
+
+		for (int k=0; k<repeat; ++k) {
+
+			dag.set_box(box, n_vars);
+
+			dag.revise_all(); // evaluates first, as the kernel
+		}
+
+		generic += clock()-start;
+
+		start = clock();
+
+		for (int k=0; k<repeat; ++k) {
+
+			kernel.set_box(&w.at(0), box);
+
+			kernel.evaluate(&w.at(0));
+
+			kernel.revise(&w.at(0));
+		}
+
+		generated += clock()-start;
+
+		for (size_t j=0; j<v.size(); ++j) {
+
+			const bool same = v.at(j).unchecked_inf()==w.at(j).unchecked_inf() &&
+                              v.at(j).unchecked_sup()==w.at(j).unchecked_sup();
+
+			ASSERT2(same, "mismatch at node "<<j<<": "<<v.at(j)<<", "<<w.at(j));
+		}
+	}
+
+	cout << "Solution boxes: " << n_sol << ", repeated " << repeat << " times" << endl;
+
+	cout << "expression_graph: " << milliseconds(generic) << " ms" << endl;
+
+	cout << "generated kernel: " << milliseconds(generated) << " ms" << endl;
+}
+
+}
@@ -28,6 +28,7 @@ namespace asol {
 template <typename T> class problem;
 class builder;
 class interval;
+struct generated_kernel;
 
 void dag_test(const problem<builder>* prob);
 
@@ -41,6 +42,8 @@ void test_solutions_revise2(const problem<builder>* prob);
 
 void test_solutions_iterative_revise(const problem<builder>* prob);
 
+void compare_revision_strategies(const problem<builder>* prob);
+
 void test_solutions_probing(const problem<builder>* prob);
 
 void extended_division_test(const problem<builder>* prob, const interval* box, const double* sol, int length);
@@ -49,6 +52,14 @@ void gap_probing_test(const problem<builder>* prob, interval* box, const double*
 
 void index_recorder_test(const problem<builder>* prob);
 
+void compare_batch_with_scalar(const problem<builder>* prob);
+
+void test_interval_newton(const problem<builder>* prob);
+
+void generate_kernel(const problem<builder>* prob, const char* name, const char* directory);
+
+void kernel_benchmark(const problem<builder>* prob, const generated_kernel& kernel, int repeat);
+
 }
 
 #endif // EXPRESSION_GRAPH_TEST_HPP_
@@ -0,0 +1,121 @@
+//==============================================================================
+//
+// This code is part of ASOL (nonlinear system solver using affine arithmetic)
+//
+// Copyright (C) 2011 Ali Baharev
+// All rights reserved. E-mail: <my_first_name.my_last_name@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//==============================================================================
+
+#include <unistd.h>
+#include "threads.hpp"
+#include "diagnostics.hpp"
+
+namespace {
+
+extern "C" void* start_routine(void* task) {
+
+	static_cast<asol::runnable*>(task)->run();
+
+	return 0;
+}
+
+}
+
+namespace asol {
+
+mutex::mutex() {
+
+	const int error = pthread_mutex_init(&m, 0);
+
+	ASSERT2(!error, "error: "<<error);
+}
+
+void mutex::lock() {
+
+	const int error = pthread_mutex_lock(&m);
+
+	ASSERT2(!error, "error: "<<error);
+}
+
+void mutex::unlock() {
+
+	const int error = pthread_mutex_unlock(&m);
+
+	ASSERT2(!error, "error: "<<error);
+}
+
+mutex::~mutex() {
+
+	pthread_mutex_destroy(&m);
+}
+
+condition::condition() {
+
+	const int error = pthread_cond_init(&c, 0);
+
+	ASSERT2(!error, "error: "<<error);
+}
+
+void condition::wait(mutex& m) {
+
+	const int error = pthread_cond_wait(&c, &m.m);
+
+	ASSERT2(!error, "error: "<<error);
+}
+
+void condition::signal() {
+
+	pthread_cond_signal(&c);
+}
+
+void condition::broadcast() {
+
+	pthread_cond_broadcast(&c);
+}
+
+condition::~condition() {
+
+	pthread_cond_destroy(&c);
+}
+
+void run_in_parallel(const std::vector<runnable*>& tasks) {
+
+	const int n = static_cast<int>(tasks.size());
+
+	std::vector<pthread_t> threads(n);
+
+	for (int i=0; i<n; ++i) {
+
+		const int error = pthread_create(&threads.at(i), 0, start_routine, tasks.at(i));
+
+		ASSERT2(!error, "failed to start thread "<<i<<", error: "<<error);
+	}
+
+	for (int i=0; i<n; ++i) {
+
+		pthread_join(threads.at(i), 0);
+	}
+}
+
+int number_of_cores() {
+
+	const long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (n > 0) ? static_cast<int>(n) : 1;
+}
+
+}
@@ -106,4 +106,22 @@ void dump(const std::vector<interval>& v, const char* filename) {
 	fclose(file);
 }
 
+void pack(const interval* box, int n, double* record) {
+
+	for (int i=0; i<n; ++i) {
+
+		*record++ = box[i].unchecked_inf();
+
+		*record++ = box[i].unchecked_sup();
+	}
+}
+
+void unpack(const double* record, int n, interval* box) {
+
+	for (int i=0; i<n; ++i, record+=2) {
+
+		box[i] = interval(record[0], record[1]);
+	}
+}
+
 }
@@ -36,8 +36,49 @@
 
 namespace asol {
 
-lp_pair* var::lp(new lp_pair);
-dag* var::ia_dag(new dag);
+__thread lp_pair* var::lp(0);
+__thread dag* var::ia_dag(0);
+__thread var_context* var::current(0);
+
+var_context::var_context() : lp(new lp_pair), ia_dag(new dag) { }
+
+void var_context::make_current() {
+
+	var::lp = lp;
+	var::ia_dag = ia_dag;
+	var::current = this;
+}
+
+void var_context::release() {
+
+	delete lp;
+	lp = 0;
+	delete ia_dag;
+	ia_dag = 0;
+
+	if (var::current == this) {
+
+		make_current();
+	}
+}
+
+var_context::~var_context() {
+
+	release();
+}
+
+namespace {
+
+struct bind_default_context {
+
+	bind_default_context() { context.make_current(); }
+
+	var_context context;
+};
+
+bind_default_context default_context;
+
+}
 
 void dbg_consistency(const var& x, const var& y) {
 	x.check_consistency();
@@ -559,11 +600,12 @@ void var::reset() {
 
 void var::release_all() {
 
-	delete lp;
-	lp = 0;
+	if (current) {
+
+		current->release();
+	}
+
 	lp_pair::free_environment();
-	delete ia_dag;
-	ia_dag = 0;
 }
 
 void var::check_consistency() const {
@@ -30,6 +30,7 @@ namespace asol {
 
 class lp_pair;
 class dag;
+class var_context;
 
 class var {
 
@@ -110,8 +111,35 @@ private:
 
 	int index;
 
-	static lp_pair* lp;
-	static dag* ia_dag;
+	friend class var_context;
+
+	// Bound by var_context::make_current(), one set per thread
+	static __thread lp_pair* lp;
+	static __thread dag* ia_dag;
+	static __thread var_context* current;
+};
+
+// Owns the LP and the interval DAG the var objects of one problem refer to;
+// a default context is current on the main thread
+class var_context {
+
+public:
+
+	var_context();
+
+	void make_current();
+
+	void release();
+
+	~var_context();
+
+private:
+
+	var_context(const var_context& );
+	var_context& operator=(const var_context& );
+
+	lp_pair* lp;
+	dag* ia_dag;
 };
 
 const var operator+(double x, const var& y);